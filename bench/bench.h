@@ -0,0 +1,36 @@
+#pragma once
+#include "perf.h"
+#include <cstdint>
+#include <cstdio>
+
+// Timing helpers for the native benchmarks (not run by ctest)
+namespace bench {
+
+// Keeps a result alive so the measured work is not optimized away
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Average nanoseconds per call of fn, over at least min_ms of calls
+// after one warm-up call
+template <typename Fn>
+double ns_per_call(Fn&& fn, uint64_t min_ms = 200) {
+    fn();
+    uint64_t calls = 0;
+    uint64_t start = perf::now_ns();
+    uint64_t elapsed = 0;
+    do {
+        for (int i = 0; i < 16; ++i) fn();
+        calls += 16;
+        elapsed = perf::now_ns() - start;
+    } while (elapsed < min_ms * 1000000);
+    return static_cast<double>(elapsed) / calls;
+}
+
+inline void row(const char* name, const char* variant, double ns,
+                const char* unit = "frame") {
+    std::printf("%-28s %-16s %12.1f ns/%s\n", name, variant, ns, unit);
+}
+
+}  // namespace bench
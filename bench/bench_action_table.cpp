@@ -0,0 +1,60 @@
+// Hotkey dispatch: the old linear scan over (id, std::function) bindings
+// against action_table::Table, per dispatch, for 3, 100 and 1000 bindings
+// with uniformly random ids
+#include "action_table.h"
+#include "bench.h"
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+uint64_t g_hits = 0;
+
+void hit() { ++g_hits; }
+void hit_slot(intptr_t slot) { g_hits += static_cast<uint64_t>(slot); }
+
+// hotkey::dispatch before the table
+struct Binding {
+    int id;
+    std::function<void()> action;
+};
+
+void run(int n) {
+    std::vector<Binding> bindings;
+    std::vector<action_table::Action> actions;
+    for (int i = 0; i < n; ++i) {
+        bindings.push_back({1 + i, hit});
+        actions.push_back(i % 2 ? action_table::Action(hit)
+                                : action_table::Action(hit_slot, i));
+    }
+    action_table::Table table;
+    table.assign(actions);
+
+    std::mt19937 rng(15);
+    std::vector<int> ids(1024);
+    for (int& id : ids) id = 1 + static_cast<int>(rng() % n);
+
+    char variant[32];
+    std::snprintf(variant, sizeof(variant), "%d bindings", n);
+    bench::row("linear scan std::function", variant, bench::ns_per_call([&] {
+        for (int id : ids) {
+            for (const auto& b : bindings) {
+                if (b.id == id) { b.action(); break; }
+            }
+        }
+    }) / ids.size(), "dispatch");
+    bench::row("action_table::Table", variant, bench::ns_per_call([&] {
+        for (int id : ids) table.dispatch(id);
+    }) / ids.size(), "dispatch");
+    bench::keep(g_hits);
+}
+
+}  // namespace
+
+int main() {
+    run(3);
+    run(100);
+    run(1000);
+    return 0;
+}
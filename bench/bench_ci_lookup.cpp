@@ -0,0 +1,50 @@
+// ci_lookup::Set against a case-insensitive linear scan, per lookup, for
+// tables of 14, 200 and 2000 keys (half of the lookups hit)
+#include "bench.h"
+#include "ci_lookup.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <size_t N>
+void run(size_t n) {
+    std::vector<std::wstring> storage;
+    for (size_t i = 0; i < n; ++i)
+        storage.push_back(L"Process" + std::to_wstring(i * 7919) + L"Host");
+    std::vector<std::wstring_view> keys(storage.begin(), storage.end());
+    auto set = std::make_unique<ci_lookup::Set<N>>();
+    set->build(keys.data(), keys.size());
+
+    std::vector<std::wstring> queries;
+    for (size_t i = 0; i < 256; ++i) {
+        queries.push_back(i % 2 ? L"PROCESS" + std::to_wstring((i * 31 % n) * 7919)
+                                    + L"HOST"
+                                : L"Unlisted" + std::to_wstring(i));
+    }
+
+    char variant[32];
+    std::snprintf(variant, sizeof(variant), "%zu keys", n);
+    bench::row("linear iequals scan", variant, bench::ns_per_call([&] {
+        for (const auto& q : queries) {
+            bool found = false;
+            for (auto k : keys) {
+                if (ci_lookup::iequals(k, q)) { found = true; break; }
+            }
+            bench::keep(found);
+        }
+    }) / queries.size(), "lookup");
+    bench::row("ci_lookup::Set", variant, bench::ns_per_call([&] {
+        for (const auto& q : queries) bench::keep(set->contains(q));
+    }) / queries.size(), "lookup");
+}
+
+}  // namespace
+
+int main() {
+    run<14>(14);
+    run<200>(200);
+    run<2000>(2000);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Display-name resolution for 500 windows: the original per-window parse
+// with a lowercase copy and linear table scan, display_name::from_path,
+// and a PID-keyed map lookup. The map row is only the lookup and string
+// copy; window_model's cache also takes a mutex and checks the process
+// handle on every hit, which this does not measure.
+#include "bench.h"
+#include "display_name.h"
+#include <cwctype>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct NameMapping {
+    const wchar_t* exe_lower;
+    const wchar_t* display;
+};
+
+constexpr NameMapping kLegacyNames[] = {
+    {L"code", L"VS Code"}, {L"msedge", L"Edge"}, {L"chrome", L"Chrome"},
+    {L"firefox", L"Firefox"}, {L"explorer", L"Explorer"},
+    {L"windowsterminal", L"Terminal"}, {L"wt", L"Terminal"},
+    {L"cmd", L"CMD"}, {L"powershell", L"PowerShell"},
+    {L"pwsh", L"PowerShell"}, {L"notepad", L"Notepad"},
+    {L"slack", L"Slack"}, {L"discord", L"Discord"}, {L"msteams", L"Teams"},
+};
+
+std::wstring legacy_from_path(const std::wstring& fullPath) {
+    size_t lastSlash = fullPath.find_last_of(L'\\');
+    std::wstring filename = (lastSlash != std::wstring::npos)
+        ? fullPath.substr(lastSlash + 1) : fullPath;
+    size_t dotPos = filename.find_last_of(L'.');
+    if (dotPos != std::wstring::npos) filename = filename.substr(0, dotPos);
+
+    std::wstring lower = filename;
+    for (auto& c : lower) c = static_cast<wchar_t>(towlower(c));
+    for (const auto& mapping : kLegacyNames) {
+        if (lower == mapping.exe_lower) return mapping.display;
+    }
+    return filename;
+}
+
+}  // namespace
+
+int main() {
+    // 500 windows over 60 processes; a third are friendly-mapped exes
+    const wchar_t* exes[] = {L"Code", L"msedge", L"chrome", L"EXPLORER",
+                             L"WindowsTerminal", L"slack"};
+    std::vector<std::wstring> paths;
+    std::vector<uint32_t> pids;
+    for (int i = 0; i < 500; ++i) {
+        int process = i % 60;
+        std::wstring exe = process % 3 == 0
+            ? exes[process % 6]
+            : L"SomeApplication" + std::to_wstring(process);
+        paths.push_back(L"C:\\Program Files\\Vendor " + std::to_wstring(process)
+                        + L"\\bin\\" + exe + L".exe");
+        pids.push_back(1000 + process * 4);
+    }
+
+    bench::row("display name x500", "legacy", bench::ns_per_call([&] {
+        for (const auto& p : paths) bench::keep(legacy_from_path(p));
+    }), "pass");
+    bench::row("display name x500", "from_path", bench::ns_per_call([&] {
+        for (const auto& p : paths)
+            bench::keep(display_name::from_path(p));
+    }), "pass");
+
+    std::unordered_map<uint32_t, std::wstring> cache;
+    for (size_t i = 0; i < paths.size(); ++i)
+        cache.emplace(pids[i], display_name::from_path(paths[i]));
+    bench::row("display name x500", "pid map lookup", bench::ns_per_call([&] {
+        for (uint32_t pid : pids) bench::keep(std::wstring(cache.find(pid)->second));
+    }), "pass");
+    return 0;
+}
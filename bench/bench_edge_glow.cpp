@@ -0,0 +1,41 @@
+// Edge glow: per-pixel legacy renderer vs the LUT / span renderer, for the
+// four edge windows and for one full-screen window
+#include "bench.h"
+#include "legacy_edge_glow.h"
+#include <vector>
+
+namespace {
+
+using GlowFn = void (*)(const render::Canvas&, int, int, int, int);
+
+double edges(GlowFn fn, int sw, int sh, std::vector<uint32_t>& buf) {
+    int g = render::edge_glow_width(sw, sh);
+    return bench::ns_per_call([&] {
+        fn({buf.data(), sw, g, sw}, 0, 0, sw, sh);
+        fn({buf.data(), sw, g, sw}, 0, sh - g, sw, sh);
+        fn({buf.data(), g, sh - 2 * g, g}, 0, g, sw, sh);
+        fn({buf.data(), g, sh - 2 * g, g}, sw - g, g, sw, sh);
+    });
+}
+
+}  // namespace
+
+int main() {
+    struct Screen { const char* name; int w, h; };
+    for (Screen s : {Screen{"1080p", 1920, 1080}, Screen{"1440p", 2560, 1440},
+                     Screen{"4K", 3840, 2160}}) {
+        std::vector<uint32_t> buf(static_cast<size_t>(s.w) * s.h);
+        bench::row("edge_glow 4 edges legacy", s.name,
+                   edges(legacy::edge_glow, s.w, s.h, buf));
+        bench::row("edge_glow 4 edges LUT", s.name,
+                   edges(render::edge_glow, s.w, s.h, buf));
+        render::Canvas full = {buf.data(), s.w, s.h, s.w};
+        bench::row("edge_glow full legacy", s.name, bench::ns_per_call([&] {
+            legacy::edge_glow(full, 0, 0, s.w, s.h);
+        }, 500));
+        bench::row("edge_glow full LUT", s.name, bench::ns_per_call([&] {
+            render::edge_glow(full, 0, 0, s.w, s.h);
+        }, 500));
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Type-to-filter cost per key for 100, 500 and 2000 windows, with a broad
+// and a narrow pattern: the incremental Matcher, which re-scores only the
+// previous matches, against re-scoring every candidate on each key
+#include "bench.h"
+#include "fuzzy_match.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const wchar_t* kNames[] = {
+    L"Chrome", L"VS Code", L"Terminal", L"Explorer", L"Slack", L"Notepad",
+    L"Edge", L"Firefox", L"Teams", L"PowerShell", L"Discord", L"CMD"};
+constexpr const wchar_t* kWords[] = {
+    L"main", L"render", L"switcher", L"report", L"inbox", L"notes",
+    L"build", L"review", L"draft", L"design", L"issue", L"window"};
+
+void run(int n, const std::wstring& pattern) {
+    std::mt19937 rng(23);
+    std::vector<std::wstring> captions;
+    for (int i = 0; i < n; ++i) {
+        captions.push_back(std::wstring(kWords[rng() % 12]) + L"_"
+                           + std::to_wstring(i) + L".cpp - "
+                           + kWords[rng() % 12] + L" - "
+                           + kNames[rng() % 12]);
+    }
+    std::vector<fuzzy_match::Candidate> c;
+    for (int i = 0; i < n; ++i) c.push_back({kNames[i % 12], captions[i]});
+
+    // The pattern typed and erased again
+    fuzzy_match::Matcher m;
+    m.set_candidates(c);
+
+    char variant[32];
+    std::snprintf(variant, sizeof(variant), "%d win \"%ls\"", n,
+                  pattern.c_str());
+    bench::row("Matcher push/pop", variant, bench::ns_per_call([&] {
+        for (wchar_t ch : pattern) m.push(ch);
+        bench::keep(m.results().size());
+        while (m.pop()) {}
+    }) / (2 * pattern.size()), "key");
+    bench::row("rescore all", variant, bench::ns_per_call([&] {
+        // The same keys, each scoring every candidate for the new prefix
+        for (size_t k = 1; k <= 2 * pattern.size(); ++k) {
+            size_t len = k <= pattern.size() ? k : 2 * pattern.size() - k;
+            std::wstring_view prefix(pattern.data(), len);
+            int hits = 0;
+            for (const auto& cand : c) {
+                hits += fuzzy_match::score(prefix, cand.name) >= 0
+                     || fuzzy_match::score(prefix, cand.caption) >= 0;
+            }
+            bench::keep(hits);
+        }
+    }) / (2 * pattern.size()), "key");
+}
+
+}  // namespace
+
+int main() {
+    // Most captions match "rend"; "ntpd" narrows to a few at once
+    for (const wchar_t* pattern : {L"rend", L"ntpd"}) {
+        run(100, pattern);
+        run(500, pattern);
+        run(2000, pattern);
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+// Each kernel on each supported ISA over 64x32 .. 3840x2160 buffers
+#include "bench.h"
+#include "pixel_kernels.h"
+#include <vector>
+
+int main() {
+    struct Size { int w, h; };
+    constexpr Size kSizes[] = {
+        {64, 32}, {256, 64}, {960, 32}, {1920, 1080}, {3840, 2160}};
+    constexpr const char* kIsaNames[] = {"scalar", "sse2", "avx2"};
+
+    for (Size s : kSizes) {
+        size_t n = static_cast<size_t>(s.w) * s.h;
+        std::vector<uint32_t> a(n, 0x80402010), b(n, 0xFF00FF00), dst(n);
+        char name[48];
+        for (int i = 0; i < 3; ++i) {
+            auto isa = static_cast<pixel::Isa>(i);
+            if (!pixel::supported(isa)) continue;
+            const auto& k = pixel::kernels(isa);
+            std::snprintf(name, sizeof(name), "set_opaque %dx%d", s.w, s.h);
+            bench::row(name, kIsaNames[i], bench::ns_per_call([&] {
+                k.set_opaque(dst.data(), n);
+            }), "buffer");
+            std::snprintf(name, sizeof(name), "lerp %dx%d", s.w, s.h);
+            bench::row(name, kIsaNames[i], bench::ns_per_call([&] {
+                k.lerp(dst.data(), a.data(), b.data(), n, 77);
+            }), "buffer");
+            std::snprintf(name, sizeof(name), "src_over %dx%d", s.w, s.h);
+            bench::row(name, kIsaNames[i], bench::ns_per_call([&] {
+                k.src_over(dst.data(), a.data(), n);
+            }), "buffer");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+// ns/frame for each animation's renderer
+#include "bench.h"
+#include "render.h"
+#include <vector>
+
+namespace {
+
+void bench_indicator() {
+    for (int size : {32, 64, 128}) {
+        std::vector<uint32_t> px(size * size);
+        render::Canvas c = {px.data(), size, size, size};
+        uint64_t t = 0;
+        char variant[32];
+        std::snprintf(variant, sizeof(variant), "%d px", size);
+        bench::row("indicator (breathing)", variant, bench::ns_per_call([&] {
+            render::indicator(c, t += 16, render::kSpinDurationMs);
+        }));
+        std::snprintf(variant, sizeof(variant), "%d px spin", size);
+        bench::row("indicator (spinning)", variant, bench::ns_per_call([&] {
+            t = (t + 16) % render::kSpinDurationMs;
+            render::indicator(c, t, t);
+        }));
+    }
+}
+
+// The four edge windows of a flash, as edge_flash builds them
+void bench_edge_glow() {
+    struct Screen { const char* name; int w, h; };
+    for (Screen s : {Screen{"1080p", 1920, 1080}, Screen{"1440p", 2560, 1440},
+                     Screen{"4K", 3840, 2160}}) {
+        int g = render::edge_glow_width(s.w, s.h);
+        std::vector<uint32_t> horiz(s.w * g);
+        std::vector<uint32_t> vert(g * (s.h - 2 * g));
+        bench::row("edge_glow (4 edges)", s.name, bench::ns_per_call([&] {
+            render::edge_glow({horiz.data(), s.w, g, s.w}, 0, 0, s.w, s.h);
+            render::edge_glow({horiz.data(), s.w, g, s.w}, 0, s.h - g, s.w,
+                              s.h);
+            render::edge_glow({vert.data(), g, s.h - 2 * g, g}, 0, g, s.w,
+                              s.h);
+            render::edge_glow({vert.data(), g, s.h - 2 * g, g}, s.w - g, g,
+                              s.w, s.h);
+        }));
+    }
+}
+
+// One line of chips across a 960 px panel
+void bench_switcher_panel() {
+    constexpr int kW = 960;
+    constexpr int kItemH = 26;
+    constexpr int kH = kItemH + 6;
+    std::vector<uint32_t> atlas(kW * kH * 2, 0xFF2A2A40);
+    std::vector<uint32_t> panel(kW * kH);
+    std::vector<render::Chip> chips;
+    for (int x = 4; x + 118 <= kW - 4; x += 120) chips.push_back({x, 3, 118});
+    render::ChipSheet sheet = {atlas.data(), kW, chips, kItemH, kH,
+                               0xFF1A1A2E};
+    render::Canvas c = {panel.data(), kW, kH, kW};
+    uint32_t total = render::switcher_intro_ms(static_cast<int>(chips.size()));
+
+    uint64_t t = 0;
+    bench::row("switcher_panel (intro)", "960 px", bench::ns_per_call([&] {
+        t = (t + 16) % total;
+        render::switcher_panel(c, sheet, 0, t);
+    }));
+    bench::row("switcher_panel (final)", "960 px", bench::ns_per_call([&] {
+        render::switcher_panel(c, sheet, 0, total);
+    }));
+    int cursor = 0;
+    bench::row("switcher_chip (cursor)", "2 chips", bench::ns_per_call([&] {
+        int next = (cursor + 1) % static_cast<int>(chips.size());
+        render::switcher_chip(c, sheet, cursor, next);
+        render::switcher_chip(c, sheet, next, next);
+        cursor = next;
+    }));
+}
+
+}  // namespace
+
+int main() {
+    bench_indicator();
+    bench_edge_glow();
+    bench_switcher_panel();
+    return 0;
+}
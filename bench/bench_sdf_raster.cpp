@@ -0,0 +1,40 @@
+// Indicator emblem per frame: the old per-pixel loop at 32 px, and each
+// sdf_raster ISA at 32 / 64 / 128 px
+#include "bench.h"
+#include "legacy_indicator.h"
+#include "sdf_raster.h"
+#include <string>
+#include <vector>
+
+int main() {
+    constexpr pixel::Isa kIsas[] = {pixel::Isa::Scalar, pixel::Isa::SSE2,
+                                    pixel::Isa::AVX2};
+    constexpr const char* kIsaNames[] = {"scalar", "SSE2", "AVX2"};
+
+    // Vary the pose so nothing folds into a constant
+    float angle = 0.0f;
+    auto next_angle = [&] {
+        angle += 0.01f;
+        if (angle > 3.1f) angle = 0.0f;
+        return angle;
+    };
+
+    std::vector<uint32_t> buf(128 * 128);
+    bench::row("indicator legacy", "32 px", bench::ns_per_call([&] {
+        legacy::indicator(buf.data(), 0.8f, next_angle());
+        bench::keep(buf[0]);
+    }));
+    for (int size : {32, 64, 128}) {
+        std::string label = std::to_string(size) + " px";
+        for (int i = 0; i < 3; ++i) {
+            if (!pixel::supported(kIsas[i])) continue;
+            std::string name = std::string("sdf_raster ") + kIsaNames[i];
+            bench::row(name.c_str(), label.c_str(), bench::ns_per_call([&] {
+                sdf_raster::render(buf.data(), size, 0.8f, next_angle(),
+                                   kIsas[i]);
+                bench::keep(buf[0]);
+            }));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Switcher render cost against the window count: the panel laid out with
+// chip_layout and drawn with render::switcher_panel the way switcher.cpp
+// does it, for 14, 100 and 500 windows, one and three visible rows. Only
+// Layout::build (once per show) should grow with the count.
+#include "bench.h"
+#include "chip_layout.h"
+#include "render.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+// switcher.cpp metrics
+constexpr int kMaxWidth = 960 - 2 * 4;
+constexpr int kSpacing = 2;
+constexpr int kPadX = 4;
+constexpr int kPadY = 3;
+constexpr int kItemH = 24;
+
+struct Panel {
+    chip_layout::Layout layout;
+    std::vector<int> widths;
+    std::vector<render::Chip> chips;  // visible only
+    std::vector<uint32_t> atlas;
+    std::vector<uint32_t> pixels;
+    int w = 0;
+    int h = 0;
+
+    void place() {
+        chips.clear();
+        for (int i = layout.first_visible(); i < layout.end_visible(); ++i)
+            chips.push_back({kPadX + layout.x(i),
+                             kPadY + layout.view_line(i) * (kItemH + kSpacing),
+                             widths[i]});
+    }
+
+    render::ChipSheet sheet() const {
+        return {atlas.data(), w, chips, kItemH, h, 0xFF1A1A2E};
+    }
+    render::Canvas canvas() { return {pixels.data(), w, h, w}; }
+    int view_cursor(int cursor) const {
+        return layout.visible(cursor) ? cursor - layout.first_visible() : -1;
+    }
+};
+
+void run(int n, int rows) {
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> width(60, 240);
+    Panel p;
+    for (int i = 0; i < n; ++i) p.widths.push_back(width(rng));
+
+    char variant[32];
+    std::snprintf(variant, sizeof(variant), "%d win %d row", n, rows);
+
+    bench::row("Layout::build", variant, bench::ns_per_call([&] {
+        p.layout.build(p.widths, kMaxWidth, rows, kSpacing);
+        bench::keep(p.layout);
+    }), "show");
+
+    p.layout.build(p.widths, kMaxWidth, rows, kSpacing);
+    p.place();
+    int lines = p.layout.visible_lines();
+    p.w = p.layout.width() + 2 * kPadX;
+    p.h = lines * kItemH + (lines - 1) * kSpacing + 2 * kPadY;
+    p.atlas.assign(static_cast<size_t>(p.w) * p.h * 2, 0xFF2A2A40);
+    p.pixels.assign(static_cast<size_t>(p.w) * p.h, 0);
+    uint32_t total =
+        render::switcher_intro_ms(static_cast<int>(p.chips.size()));
+
+    uint64_t t = 0;
+    bench::row("switcher_panel intro", variant, bench::ns_per_call([&] {
+        t = (t + 16) % total;
+        render::switcher_panel(p.canvas(), p.sheet(), 0, t);
+    }));
+    bench::row("switcher_panel final", variant, bench::ns_per_call([&] {
+        render::switcher_panel(p.canvas(), p.sheet(), 0, total);
+    }));
+
+    // Tab through every window: two chips repainted, or a re-place and a
+    // full frame when the viewport scrolls (the atlas rebuild is GDI work
+    // and not part of this)
+    int cursor = 0;
+    p.layout.scroll_to(0);
+    p.place();
+    bench::row("cursor move", variant, bench::ns_per_call([&] {
+        int next = (cursor + 1) % n;
+        if (p.layout.scroll_to(next)) {
+            p.place();
+            render::switcher_panel(p.canvas(), p.sheet(),
+                                   p.view_cursor(next), total);
+        } else {
+            render::switcher_chip(p.canvas(), p.sheet(),
+                                  p.view_cursor(cursor), p.view_cursor(next));
+            render::switcher_chip(p.canvas(), p.sheet(),
+                                  p.view_cursor(next), p.view_cursor(next));
+        }
+        cursor = next;
+    }), "move");
+}
+
+}  // namespace
+
+int main() {
+    for (int rows : {1, 3}) {
+        for (int n : {14, 100, 500}) run(n, rows);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Dense id -> action table for hotkey dispatch.
+// Ids are handed out in order from first_id when the table is built, so a
+// lookup is one bounds check and one index. Actions are plain function
+// pointers (optionally with one word of context) and never allocate.
+namespace action_table {
+
+class Action {
+public:
+    constexpr Action() = default;
+
+    // Any captureless callable, e.g. [] { switcher::toggle(); }
+    template <typename F>
+        requires std::is_convertible_v<F, void (*)()>
+    constexpr Action(F fn) : fn0_(static_cast<void (*)()>(fn)) {}
+
+    // fn(arg), e.g. a slot index for "jump to slot N"
+    constexpr Action(void (*fn)(intptr_t), intptr_t arg)
+        : fn1_(fn), arg_(arg) {}
+
+    explicit constexpr operator bool() const { return fn0_ || fn1_; }
+
+    void operator()() const {
+        if (fn0_)
+            fn0_();
+        else if (fn1_)
+            fn1_(arg_);
+    }
+
+private:
+    void (*fn0_)() = nullptr;
+    void (*fn1_)(intptr_t) = nullptr;
+    intptr_t arg_ = 0;
+};
+
+class Table {
+public:
+    explicit Table(int first_id = 1) : first_id_(first_id) {}
+
+    // Replace the contents; actions[i] gets id first_id + i. The only
+    // allocation happens here.
+    void assign(std::span<const Action> actions) {
+        actions_.assign(actions.begin(), actions.end());
+    }
+
+    int id_of(size_t index) const {
+        return first_id_ + static_cast<int>(index);
+    }
+
+    // Runs the action for id; false if id is not in the table
+    bool dispatch(int id) const {
+        size_t i = static_cast<size_t>(static_cast<unsigned>(id - first_id_));
+        if (i >= actions_.size()) return false;
+        actions_[i]();
+        return true;
+    }
+
+    size_t size() const { return actions_.size(); }
+    bool empty() const { return actions_.empty(); }
+
+    void clear() { actions_.clear(); }
+
+    void swap(Table& other) noexcept {
+        std::swap(first_id_, other.first_id_);
+        actions_.swap(other.actions_);
+    }
+
+private:
+    int first_id_;
+    std::vector<Action> actions_;
+};
+
+}  // namespace action_table
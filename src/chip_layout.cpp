@@ -0,0 +1,53 @@
+#include "chip_layout.h"
+#include <algorithm>
+
+namespace chip_layout {
+
+void Layout::build(std::span<const int> widths, int max_width, int max_rows,
+                   int spacing) {
+    size_t n = widths.size();
+    x_.resize(n);
+    line_of_.resize(n);
+    line_start_.clear();
+    max_rows_ = std::max(max_rows, 1);
+    width_ = 0;
+    first_line_ = 0;
+
+    int x = 0;
+    for (size_t i = 0; i < n; ++i) {
+        // A chip wider than max_width gets a line of its own
+        if (i == 0 || (x > 0 && x + widths[i] > max_width)) {
+            line_start_.push_back(static_cast<int>(i));
+            x = 0;
+        }
+        x_[i] = x;
+        line_of_[i] = static_cast<int>(line_start_.size()) - 1;
+        x += widths[i];
+        width_ = std::max(width_, x);
+        x += spacing;
+    }
+    line_start_.push_back(static_cast<int>(n));
+}
+
+int Layout::visible_lines() const {
+    return std::min(lines(), max_rows_);
+}
+
+bool Layout::scroll_to(int i) {
+    if (i < 0 || i >= count()) return false;
+    int line = line_of_[i];
+    int first = first_line_;
+    if (line < first)
+        first = line;
+    else if (line >= first + max_rows_)
+        first = line - max_rows_ + 1;
+    if (first == first_line_) return false;
+    first_line_ = first;
+    return true;
+}
+
+int Layout::end_visible() const {
+    return line_start_[std::min(first_line_ + max_rows_, lines())];
+}
+
+}  // namespace chip_layout
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Line layout and viewport for the switcher chips. Chips flow left to
+// right and wrap into lines no wider than max_width; the viewport shows up
+// to max_rows consecutive lines and scrolls by whole lines, so chips are
+// never cut at its edges. With max_rows == 1 each line is one page.
+// Everything the renderer needs is limited to the visible lines, so its
+// cost does not grow with the chip count.
+namespace chip_layout {
+
+class Layout {
+public:
+    // Lay out chips of the given widths; resets the viewport to line 0
+    void build(std::span<const int> widths, int max_width, int max_rows,
+               int spacing);
+
+    int count() const { return static_cast<int>(line_of_.size()); }
+    int lines() const { return static_cast<int>(line_start_.size()) - 1; }
+    int visible_lines() const;
+    // Widest line; the viewport width, fixed while scrolling
+    int width() const { return width_; }
+
+    // Scroll the fewest lines that bring chip i into view; true if the
+    // visible range changed
+    bool scroll_to(int i);
+    int first_line() const { return first_line_; }
+
+    // Visible chips are [first_visible(), end_visible())
+    int first_visible() const { return line_start_[first_line_]; }
+    int end_visible() const;
+    bool visible(int i) const {
+        return i >= first_visible() && i < end_visible();
+    }
+
+    // Position of chip i: x from the line start, line relative to the
+    // first visible line
+    int x(int i) const { return x_[i]; }
+    int view_line(int i) const { return line_of_[i] - first_line_; }
+
+private:
+    std::vector<int> x_;
+    std::vector<int> line_of_;
+    std::vector<int> line_start_;  // first chip of each line, then count()
+    int max_rows_ = 1;
+    int width_ = 0;
+    int first_line_ = 0;
+};
+
+}  // namespace chip_layout
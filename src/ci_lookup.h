@@ -0,0 +1,232 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Case-insensitive perfect-hash lookup over wide-string keys.
+// Built by hash-and-displace: keys are grouped into buckets by one half of
+// a 64-bit hash, and each bucket gets a seed that scatters its keys into
+// free slots. A lookup is one hash pass, one seed fetch and one compare,
+// with no heap allocation. Tables can be built at compile time (make_map /
+// make_set) or at runtime from user-supplied keys (build()).
+// Case folding covers ASCII only, which is what exe and class names use.
+namespace ci_lookup {
+
+constexpr wchar_t fold(wchar_t c) {
+    return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c + (L'a' - L'A'))
+                                    : c;
+}
+
+constexpr bool iequals(std::wstring_view a, std::wstring_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (fold(a[i]) != fold(b[i])) return false;
+    }
+    return true;
+}
+
+// FNV-1a over folded code units
+constexpr uint64_t hash(std::wstring_view s) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (wchar_t c : s) {
+        h ^= static_cast<uint32_t>(fold(c));
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+// splitmix64 finalizer
+constexpr uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+// Keys are stored as views; runtime-built tables require the key storage
+// to outlive the table.
+template <typename V, size_t Capacity>
+class Map {
+    static_assert(Capacity > 0);
+
+public:
+    static constexpr size_t kBuckets = Capacity;
+    static constexpr size_t kSlots = std::bit_ceil(Capacity * 2);
+
+    constexpr Map() = default;
+
+    // Replaces the contents. Empty keys are ignored and later duplicates of
+    // a key lose to the first. Returns false if n exceeds Capacity or no
+    // displacement could be found (the table is left empty).
+    constexpr bool build(const std::wstring_view* keys, const V* values,
+                         size_t n) {
+        clear();
+        if (n > Capacity) return false;
+
+        std::array<uint64_t, Capacity> hashes{};
+        std::array<uint32_t, Capacity> bucket_of{};
+        std::array<uint32_t, kBuckets> bucket_size{};
+        std::array<uint32_t, Capacity> order{};
+        for (size_t i = 0; i < n; ++i) {
+            hashes[i] = hash(keys[i]);
+            bucket_of[i] = static_cast<uint32_t>((hashes[i] >> 32) % kBuckets);
+            bucket_size[bucket_of[i]]++;
+            order[i] = static_cast<uint32_t>(i);
+        }
+        // Place the largest buckets first while the table is emptiest
+        std::sort(order.begin(), order.begin() + n,
+                  [&](uint32_t a, uint32_t b) {
+                      uint32_t ba = bucket_of[a], bb = bucket_of[b];
+                      if (bucket_size[ba] != bucket_size[bb])
+                          return bucket_size[ba] > bucket_size[bb];
+                      return ba != bb ? ba < bb : a < b;
+                  });
+
+        std::array<uint32_t, Capacity> placed{};
+        size_t group = 0;
+        while (group < n) {
+            uint32_t b = bucket_of[order[group]];
+            size_t end = group;
+            while (end < n && bucket_of[order[end]] == b) ++end;
+
+            bool ok = false;
+            for (uint32_t seed = 1; seed < kMaxSeed && !ok; ++seed) {
+                size_t count = 0;
+                ok = true;
+                for (size_t k = group; k < end; ++k) {
+                    uint32_t item = order[k];
+                    if (keys[item].empty() || is_duplicate(keys, order, group,
+                                                           k)) {
+                        continue;
+                    }
+                    size_t slot = slot_of(hashes[item], seed);
+                    if (!slots_[slot].key.empty()) {
+                        ok = false;
+                        break;
+                    }
+                    slots_[slot] = {keys[item], values[item]};
+                    placed[count++] = static_cast<uint32_t>(slot);
+                }
+                if (ok) {
+                    seeds_[b] = seed;
+                    size_ += count;
+                } else {
+                    for (size_t k = 0; k < count; ++k)
+                        slots_[placed[k]] = {};
+                }
+            }
+            if (!ok) {
+                clear();
+                return false;
+            }
+            group = end;
+        }
+        return true;
+    }
+
+    constexpr const V* find(std::wstring_view key) const {
+        if (key.empty()) return nullptr;
+        uint64_t h = hash(key);
+        uint32_t seed = seeds_[(h >> 32) % kBuckets];
+        if (seed == 0) return nullptr;
+        const Slot& s = slots_[slot_of(h, seed)];
+        return iequals(s.key, key) ? &s.value : nullptr;
+    }
+
+    constexpr bool contains(std::wstring_view key) const {
+        return find(key) != nullptr;
+    }
+
+    constexpr size_t size() const { return size_; }
+
+    constexpr void clear() {
+        seeds_ = {};
+        slots_ = {};
+        size_ = 0;
+    }
+
+private:
+    static constexpr uint32_t kMaxSeed = 1u << 20;
+
+    struct Slot {
+        std::wstring_view key;
+        V value{};
+    };
+
+    static constexpr size_t slot_of(uint64_t h, uint32_t seed) {
+        return static_cast<size_t>(mix(h ^ (seed * 0x9E3779B97F4A7C15ull)))
+             & (kSlots - 1);
+    }
+
+    // Equal keys always share a bucket, so only earlier group members
+    // need to be checked
+    static constexpr bool is_duplicate(
+        const std::wstring_view* keys,
+        const std::array<uint32_t, Capacity>& order, size_t group, size_t k) {
+        for (size_t j = group; j < k; ++j) {
+            if (iequals(keys[order[j]], keys[order[k]])) return true;
+        }
+        return false;
+    }
+
+    std::array<uint32_t, kBuckets> seeds_{};  // 0 = empty bucket
+    std::array<Slot, kSlots> slots_{};
+    size_t size_ = 0;
+};
+
+template <size_t Capacity>
+class Set {
+public:
+    constexpr bool build(const std::wstring_view* keys, size_t n) {
+        if (n > Capacity) {
+            map_.clear();
+            return false;
+        }
+        std::array<bool, Capacity> present{};
+        present.fill(true);
+        return map_.build(keys, present.data(), n);
+    }
+    constexpr bool contains(std::wstring_view key) const {
+        return map_.contains(key);
+    }
+    constexpr size_t size() const { return map_.size(); }
+    constexpr void clear() { map_.clear(); }
+
+private:
+    Map<bool, Capacity> map_;
+};
+
+template <typename V>
+struct Entry {
+    std::wstring_view key;
+    V value;
+};
+
+// Compile-time construction; a failed build is a compile error
+template <typename V, size_t N>
+constexpr Map<V, N> make_map(const Entry<V> (&entries)[N]) {
+    std::array<std::wstring_view, N> keys{};
+    std::array<V, N> values{};
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = entries[i].key;
+        values[i] = entries[i].value;
+    }
+    Map<V, N> m;
+    if (!m.build(keys.data(), values.data(), N))
+        throw "ci_lookup: no perfect hash found";
+    return m;
+}
+
+template <size_t N>
+constexpr Set<N> make_set(const std::wstring_view (&keys)[N]) {
+    Set<N> s;
+    if (!s.build(keys, N)) throw "ci_lookup: no perfect hash found";
+    return s;
+}
+
+}  // namespace ci_lookup
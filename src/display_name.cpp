@@ -0,0 +1,43 @@
+#include "display_name.h"
+#include "ci_lookup.h"
+
+namespace display_name {
+namespace {
+
+// Exe name -> friendly display name mapping (keys are case-insensitive)
+constexpr auto kFriendlyNames = ci_lookup::make_map<std::wstring_view>({
+    {L"code", L"VS Code"},
+    {L"msedge", L"Edge"},
+    {L"chrome", L"Chrome"},
+    {L"firefox", L"Firefox"},
+    {L"explorer", L"Explorer"},
+    {L"windowsterminal", L"Terminal"},
+    {L"wt", L"Terminal"},
+    {L"cmd", L"CMD"},
+    {L"powershell", L"PowerShell"},
+    {L"pwsh", L"PowerShell"},
+    {L"notepad", L"Notepad"},
+    {L"slack", L"Slack"},
+    {L"discord", L"Discord"},
+    {L"msteams", L"Teams"},
+});
+
+}  // namespace
+
+std::wstring from_path(std::wstring_view path) {
+    size_t lastSlash = path.find_last_of(L'\\');
+    std::wstring_view filename = (lastSlash != std::wstring_view::npos)
+        ? path.substr(lastSlash + 1) : path;
+
+    size_t dotPos = filename.find_last_of(L'.');
+    if (dotPos != std::wstring_view::npos) {
+        filename = filename.substr(0, dotPos);
+    }
+
+    if (const auto* display = kFriendlyNames.find(filename))
+        return std::wstring(*display);
+
+    return std::wstring(filename);
+}
+
+}  // namespace display_name
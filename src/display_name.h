@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// Process image path -> switcher display name: the exe name without
+// directory and extension, or its friendly name if it has one
+// ("C:\...\msedge.exe" -> "Edge"). Matching is ASCII case-insensitive.
+namespace display_name {
+
+std::wstring from_path(std::wstring_view path);
+
+}  // namespace display_name
@@ -1,112 +1,197 @@
 #include "edge_flash.h"
+#include "frame_scheduler.h"
+#include "perf.h"
+#include "render.h"
 #include <cstdint>
-#include <algorithm>
 
 namespace edge_flash {
 namespace {
 
 constexpr wchar_t kClassName[] = L"CustomKeypadEdgeFlash";
 
-constexpr UINT_PTR kTimerId = 1;
-constexpr DWORD kFrameMs = 16;       // ~60 fps
 constexpr DWORD kDurationMs = 500;
-constexpr int kGlowWidth = 40;       // px from screen edge
 
-// Accent color (same as indicator: #008CB4)
-constexpr float kR = 0.0f;
-constexpr float kG = 140.0f / 255.0f;
-constexpr float kB = 180.0f / 255.0f;
+// One layered window with its own DIB, covering rc in screen coordinates
+struct Surface {
+    HWND hwnd = nullptr;
+    HDC hdc = nullptr;
+    HBITMAP hbmp = nullptr;
+    HGDIOBJ oldBmp = nullptr;  // hdc's stock bitmap, selected back on delete
+    uint32_t* pixels = nullptr;
+    RECT rc = {};
+};
+
+// FullScreen uses surface 0 only; Edges uses top, bottom, left, right
+constexpr int kMaxSurfaces = 4;
 
 HINSTANCE g_hInstance = nullptr;
-HWND g_hwnd = nullptr;
-HDC g_hdcMem = nullptr;
-HBITMAP g_hbmp = nullptr;
-uint32_t* g_pixels = nullptr;
-int g_width = 0;
-int g_height = 0;
+Mode g_mode = Mode::Edges;
+Surface g_surfaces[kMaxSurfaces];
+int g_surfaceCount = 0;
+int g_screenW = 0;       // screen size the surfaces were built for
+int g_screenH = 0;
+bool g_stale = false;    // display configuration changed; rebuild on next use
+bool g_flashing = false;
 ULONGLONG g_startTick = 0;
 
-void cleanup() {
-    if (g_hwnd) {
-        KillTimer(g_hwnd, kTimerId);
-        DestroyWindow(g_hwnd);
-        g_hwnd = nullptr;
-    }
-    if (g_hbmp) { DeleteObject(g_hbmp); g_hbmp = nullptr; }
-    if (g_hdcMem) { DeleteDC(g_hdcMem); g_hdcMem = nullptr; }
-    g_pixels = nullptr;
-    g_width = 0;
-    g_height = 0;
-}
+perf::Gauge g_fullBytes{"edge_flash.full_screen.dib_bytes"};
+perf::Gauge g_edgeBytes{"edge_flash.edges.dib_bytes"};
+perf::Histogram g_fullFirstFrame{"edge_flash.full_screen.first_frame"};
+perf::Histogram g_edgeFirstFrame{"edge_flash.edges.first_frame"};
+perf::Counter g_surfaceRebuilds{"edge_flash.surface_rebuilds"};
+
+void tick();
+frame_scheduler::Animation g_anim{"edge_flash.frame", tick};
 
-// Render a single glow pixel (premultiplied BGRA)
-inline uint32_t glow_pixel(int dist) {
-    float t = static_cast<float>(dist) / kGlowWidth;
-    float s = 1.0f - t;
-    float a = s * s * s;  // cubic falloff for soft blur
-
-    auto to_byte = [](float v) -> uint32_t {
-        return static_cast<uint32_t>(v * 255.0f);
-    };
-    return (to_byte(a) << 24) |
-           (to_byte(kR * a) << 16) |
-           (to_byte(kG * a) << 8) |
-           to_byte(kB * a);
+perf::Gauge& dib_bytes() {
+    return g_mode == Mode::Edges ? g_edgeBytes : g_fullBytes;
 }
 
-void render_glow(int sw, int sh) {
-    ZeroMemory(g_pixels, sw * sh * sizeof(uint32_t));
-
-    int gw = std::min(kGlowWidth, std::min(sw / 2, sh / 2));
-
-    for (int y = 0; y < sh; ++y) {
-        int dy = std::min(y, sh - 1 - y);
-        if (dy >= gw) {
-            // Center rows: only left and right edges
-            for (int x = 0; x < gw; ++x) {
-                uint32_t px = glow_pixel(x);
-                g_pixels[y * sw + x] = px;
-                g_pixels[y * sw + (sw - 1 - x)] = px;
-            }
-        } else {
-            // Edge rows: full width
-            for (int x = 0; x < sw; ++x) {
-                int dx = std::min(x, sw - 1 - x);
-                int d = std::min(dx, dy);
-                if (d >= gw) continue;
-                g_pixels[y * sw + x] = glow_pixel(d);
-            }
+int width(const RECT& rc) { return rc.right - rc.left; }
+int height(const RECT& rc) { return rc.bottom - rc.top; }
+
+// Destroy windows and bitmaps
+void destroy_surfaces() {
+    frame_scheduler::stop(g_anim);
+    for (int i = 0; i < g_surfaceCount; ++i) {
+        Surface& s = g_surfaces[i];
+        if (s.hwnd) { DestroyWindow(s.hwnd); s.hwnd = nullptr; }
+        // A bitmap still selected into a DC cannot be deleted
+        if (s.oldBmp) { SelectObject(s.hdc, s.oldBmp); s.oldBmp = nullptr; }
+        if (s.hbmp) {
+            if (!DeleteObject(s.hbmp))
+                OutputDebugStringA("[edge_flash] DeleteObject failed\n");
+            dib_bytes().add(-int64_t{4} * width(s.rc) * height(s.rc));
+            s.hbmp = nullptr;
         }
+        if (s.hdc) {
+            if (!DeleteDC(s.hdc))
+                OutputDebugStringA("[edge_flash] DeleteDC failed\n");
+            s.hdc = nullptr;
+        }
+        s.pixels = nullptr;
     }
+    g_surfaceCount = 0;
+    g_screenW = 0;
+    g_screenH = 0;
+    g_stale = false;
+    g_flashing = false;
 }
 
-LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
-    if (msg == WM_TIMER && wp == kTimerId) {
-        float t = static_cast<float>(GetTickCount64() - g_startTick) / kDurationMs;
-        if (t >= 1.0f) {
-            cleanup();
-            return 0;
+// End of a flash: hide the windows but keep them for the next one
+void end_flash() {
+    frame_scheduler::stop(g_anim);
+    for (int i = 0; i < g_surfaceCount; ++i)
+        ShowWindow(g_surfaces[i].hwnd, SW_HIDE);
+    g_flashing = false;
+}
+
+void render_glow(const Surface& s, int sw, int sh) {
+    render::Canvas c = {s.pixels, width(s.rc), height(s.rc), width(s.rc)};
+    render::edge_glow(c, s.rc.left, s.rc.top, sw, sh);
+}
+
+bool create_surface(Surface& s) {
+    constexpr DWORD exStyle = WS_EX_TOPMOST | WS_EX_TOOLWINDOW
+                            | WS_EX_NOACTIVATE | WS_EX_LAYERED
+                            | WS_EX_TRANSPARENT;
+    s.hwnd = CreateWindowExW(exStyle, kClassName, L"", WS_POPUP,
+                             s.rc.left, s.rc.top, width(s.rc), height(s.rc),
+                             nullptr, nullptr, g_hInstance, nullptr);
+    if (!s.hwnd) return false;
+
+    HDC hdcScreen = GetDC(nullptr);
+    s.hdc = CreateCompatibleDC(hdcScreen);
+    ReleaseDC(nullptr, hdcScreen);
+
+    BITMAPINFO bmi = {};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = width(s.rc);
+    bmi.bmiHeader.biHeight = -height(s.rc);  // top-down
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    s.hbmp = CreateDIBSection(s.hdc, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (!s.hbmp) return false;
+    s.pixels = static_cast<uint32_t*>(bits);
+    s.oldBmp = SelectObject(s.hdc, s.hbmp);
+    dib_bytes().add(int64_t{4} * width(s.rc) * height(s.rc));
+    return true;
+}
+
+// Build windows and pre-rendered glow for an sw x sh screen. Existing
+// surfaces are reused unless the display configuration changed.
+bool prepare_surfaces(int sw, int sh) {
+    if (g_surfaceCount > 0 && !g_stale && g_screenW == sw && g_screenH == sh)
+        return true;
+    destroy_surfaces();
+    g_surfaceRebuilds.add();
+
+    if (g_mode == Mode::FullScreen) {
+        g_surfaces[g_surfaceCount++].rc = {0, 0, sw, sh};
+    } else {
+        int gw = render::edge_glow_width(sw, sh);
+        if (gw <= 0) return false;
+        g_surfaces[g_surfaceCount++].rc = {0, 0, sw, gw};
+        g_surfaces[g_surfaceCount++].rc = {0, sh - gw, sw, sh};
+        if (sh - 2 * gw > 0) {
+            g_surfaces[g_surfaceCount++].rc = {0, gw, gw, sh - gw};
+            g_surfaces[g_surfaceCount++].rc = {sw - gw, gw, sw, sh - gw};
         }
+    }
 
-        // Quick rise, gradual fade
-        float envelope;
-        if (t < 0.15f) {
-            float s = t / 0.15f;
-            envelope = s * s;
-        } else {
-            float s = (t - 0.15f) / 0.85f;
-            envelope = (1.0f - s) * (1.0f - s);
+    for (int i = 0; i < g_surfaceCount; ++i) {
+        if (!create_surface(g_surfaces[i])) {
+            destroy_surfaces();
+            return false;
         }
+        render_glow(g_surfaces[i], sw, sh);
+    }
+    g_screenW = sw;
+    g_screenH = sh;
+    return true;
+}
 
-        BYTE alpha = static_cast<BYTE>(envelope * 140.0f);
+void update_alpha(BYTE alpha) {
+    for (int i = 0; i < g_surfaceCount; ++i) {
+        const Surface& s = g_surfaces[i];
         POINT ptSrc = {0, 0};
-        SIZE sz = {g_width, g_height};
+        SIZE sz = {width(s.rc), height(s.rc)};
         BLENDFUNCTION blend = {};
         blend.BlendOp = AC_SRC_OVER;
         blend.SourceConstantAlpha = alpha;
         blend.AlphaFormat = AC_SRC_ALPHA;
-        UpdateLayeredWindow(hwnd, nullptr, nullptr, &sz,
-                            g_hdcMem, &ptSrc, 0, &blend, ULW_ALPHA);
+        UpdateLayeredWindow(s.hwnd, nullptr, nullptr, &sz,
+                            s.hdc, &ptSrc, 0, &blend, ULW_ALPHA);
+    }
+}
+
+void tick() {
+    float t = static_cast<float>(GetTickCount64() - g_startTick) / kDurationMs;
+    if (t >= 1.0f) {
+        end_flash();
+        return;
+    }
+
+    // Quick rise, gradual fade
+    float envelope;
+    if (t < 0.15f) {
+        float s = t / 0.15f;
+        envelope = s * s;
+    } else {
+        float s = (t - 0.15f) / 0.85f;
+        envelope = (1.0f - s) * (1.0f - s);
+    }
+
+    update_alpha(static_cast<BYTE>(envelope * 140.0f));
+}
+
+LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
+    if (msg == WM_DISPLAYCHANGE) {
+        // Every surface gets this; rebuild lazily on the next flash
+        g_stale = true;
         return 0;
     }
     return DefWindowProcW(hwnd, msg, wp, lp);
@@ -114,8 +199,9 @@ LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
 
 }  // namespace
 
-bool init(HINSTANCE hInstance) {
+bool init(HINSTANCE hInstance, Mode mode) {
     g_hInstance = hInstance;
+    g_mode = mode;
 
     WNDCLASSEXW wc = {};
     wc.cbSize = sizeof(wc);
@@ -127,64 +213,31 @@ bool init(HINSTANCE hInstance) {
 }
 
 void flash() {
-    // Restart if already flashing
-    if (g_hwnd) cleanup();
+    uint64_t start = perf::now_ns();
 
     int sw = GetSystemMetrics(SM_CXSCREEN);
     int sh = GetSystemMetrics(SM_CYSCREEN);
+    if (!prepare_surfaces(sw, sh)) return;
 
-    constexpr DWORD exStyle = WS_EX_TOPMOST | WS_EX_TOOLWINDOW
-                            | WS_EX_NOACTIVATE | WS_EX_LAYERED
-                            | WS_EX_TRANSPARENT;
-    g_hwnd = CreateWindowExW(exStyle, kClassName, L"", WS_POPUP,
-                              0, 0, sw, sh,
-                              nullptr, nullptr, g_hInstance, nullptr);
-    if (!g_hwnd) return;
-
-    // Create DIB
-    HDC hdcScreen = GetDC(nullptr);
-    g_hdcMem = CreateCompatibleDC(hdcScreen);
-    ReleaseDC(nullptr, hdcScreen);
-
-    BITMAPINFO bmi = {};
-    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bmi.bmiHeader.biWidth = sw;
-    bmi.bmiHeader.biHeight = -sh;  // top-down
-    bmi.bmiHeader.biPlanes = 1;
-    bmi.bmiHeader.biBitCount = 32;
-    bmi.bmiHeader.biCompression = BI_RGB;
-
-    void* bits = nullptr;
-    g_hbmp = CreateDIBSection(g_hdcMem, &bmi, DIB_RGB_COLORS,
-                               &bits, nullptr, 0);
-    if (!g_hbmp) { cleanup(); return; }
-    g_pixels = static_cast<uint32_t*>(bits);
-    SelectObject(g_hdcMem, g_hbmp);
-    g_width = sw;
-    g_height = sh;
-
-    // Pre-render the glow pattern
-    render_glow(sw, sh);
-
-    // Show with initial alpha = 0
+    // Restart the envelope; windows that are already up keep their place
     g_startTick = GetTickCount64();
+    update_alpha(0);
+    if (!g_flashing) {
+        for (int i = 0; i < g_surfaceCount; ++i) {
+            const Surface& s = g_surfaces[i];
+            SetWindowPos(s.hwnd, HWND_TOPMOST, s.rc.left, s.rc.top, 0, 0,
+                         SWP_NOSIZE | SWP_NOACTIVATE | SWP_SHOWWINDOW);
+        }
+        g_flashing = true;
+    }
+    frame_scheduler::start(g_anim);
 
-    POINT ptDst = {0, 0};
-    POINT ptSrc = {0, 0};
-    SIZE sz = {sw, sh};
-    BLENDFUNCTION blend = {};
-    blend.BlendOp = AC_SRC_OVER;
-    blend.SourceConstantAlpha = 0;
-    blend.AlphaFormat = AC_SRC_ALPHA;
-    UpdateLayeredWindow(g_hwnd, nullptr, &ptDst, &sz,
-                        g_hdcMem, &ptSrc, 0, &blend, ULW_ALPHA);
-
-    ShowWindow(g_hwnd, SW_SHOWNOACTIVATE);
-    SetTimer(g_hwnd, kTimerId, kFrameMs, nullptr);
+    (g_mode == Mode::Edges ? g_edgeFirstFrame : g_fullFirstFrame)
+        .record(perf::now_ns() - start);
 }
 
 void shutdown() {
-    cleanup();
+    destroy_surfaces();
     UnregisterClassW(kClassName, g_hInstance);
 }
 
@@ -3,7 +3,14 @@
 
 namespace edge_flash {
 
-bool init(HINSTANCE hInstance);
+// Surfaces are kept (hidden) between flashes and rebuilt only when the
+// display configuration changes
+enum class Mode {
+    Edges,       // four thin windows along the screen edges
+    FullScreen,  // one screen-sized window
+};
+
+bool init(HINSTANCE hInstance, Mode mode = Mode::Edges);
 void flash();
 void shutdown();
 
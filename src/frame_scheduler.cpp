@@ -0,0 +1,162 @@
+#include "frame_scheduler.h"
+#include <algorithm>
+#include <cstdint>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace frame_scheduler {
+namespace {
+
+constexpr uint64_t kFrameNs = 16'666'667;  // 60 fps
+// A shared frame due this close to a wakeup is done in it rather than in
+// one more
+constexpr uint64_t kSlackNs = 1'000'000;
+constexpr int kMaxAnimations = 8;
+
+HANDLE g_timer = nullptr;
+Animation* g_active[kMaxAnimations] = {};
+int g_activeCount = 0;
+uint64_t g_nextFrame = 0;  // perf::now_ns() deadline the timer is armed for
+uint64_t g_sharedFrame = 0;  // next frame for animations without a due time
+uint64_t g_lastTick = 0;   // 0 = no tick yet in this run
+bool g_ticking = false;
+
+perf::Rate g_wakeups{"frame_scheduler.wakeups"};
+perf::Rate g_ticks{"frame_scheduler.ticks"};
+perf::Histogram g_interval{"frame_scheduler.interval"};
+
+void arm(uint64_t deadline) {
+    g_nextFrame = deadline;
+    uint64_t now = perf::now_ns();
+    // Negative = relative, in 100 ns units
+    LARGE_INTEGER due;
+    due.QuadPart = -std::max<LONGLONG>(
+        1, deadline > now ? static_cast<LONGLONG>((deadline - now) / 100) : 0);
+    SetWaitableTimer(g_timer, &due, 0, nullptr, nullptr, FALSE);
+}
+
+// Arm for the earliest active animation
+void reschedule() {
+    uint64_t earliest = UINT64_MAX;
+    for (int i = 0; i < g_activeCount; ++i) {
+        uint64_t due = g_active[i]->due_ns;
+        earliest = std::min(earliest, due ? due : g_sharedFrame);
+    }
+    if (earliest != UINT64_MAX) arm(earliest);
+}
+
+void go_idle() {
+    CancelWaitableTimer(g_timer);
+    g_ticks.end();
+    g_lastTick = 0;
+}
+
+void tick_all() {
+    uint64_t now = perf::now_ns();
+    if (g_lastTick != 0) g_interval.record(now - g_lastTick);
+    g_lastTick = now;
+    g_ticks.add();
+
+    bool shared = g_sharedFrame <= now + kSlackNs;
+
+    // Ticks may start or stop animations; walk a snapshot
+    Animation* active[kMaxAnimations];
+    int n = g_activeCount;
+    std::copy_n(g_active, n, active);
+    g_ticking = true;
+    for (int i = 0; i < n; ++i) {
+        Animation* a = active[i];
+        if (!a->active) continue;  // stopped by an earlier tick
+        // A due time is never served early, so the tick sees its change
+        if (a->due_ns ? a->due_ns > now : !shared) continue;
+        a->due_ns = 0;
+        perf::ScopedTimer timer(a->frame_time);
+        a->tick();
+    }
+    g_ticking = false;
+    if (g_activeCount == 0) return;
+
+    // Keep a fixed cadence; after a stall resume from now instead of
+    // firing a burst of late frames
+    if (shared) {
+        g_sharedFrame += kFrameNs;
+        uint64_t after = perf::now_ns();
+        if (g_sharedFrame <= after) g_sharedFrame = after + kFrameNs;
+    }
+    reschedule();
+}
+
+}  // namespace
+
+bool init() {
+    // High-resolution timers (Windows 10 1803+) are not rounded up to the
+    // 15.6 ms system tick; older systems get a plain timer
+    g_timer = CreateWaitableTimerExW(nullptr, nullptr,
+                                     CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                     TIMER_ALL_ACCESS);
+    if (!g_timer)
+        g_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    if (!g_timer) return false;
+    g_wakeups.begin();
+    return true;
+}
+
+void start(Animation& a) {
+    if (a.active || !g_timer || g_activeCount == kMaxAnimations) return;
+    a.active = true;
+    a.due_ns = 0;
+    g_active[g_activeCount++] = &a;
+    if (g_activeCount == 1) g_ticks.begin();
+    // The shared frame may have lapsed while every animation was asleep
+    uint64_t now = perf::now_ns();
+    if (g_sharedFrame <= now) g_sharedFrame = now + kFrameNs;
+    if (!g_ticking) reschedule();
+}
+
+void wake_at(Animation& a, uint64_t due_ns) {
+    a.due_ns = due_ns;
+    if (!a.active) return;
+    uint64_t now = perf::now_ns();
+    if (due_ns == 0 && g_sharedFrame <= now) g_sharedFrame = now + kFrameNs;
+    if (!g_ticking) reschedule();
+}
+
+void stop(Animation& a) {
+    if (!a.active) return;
+    a.active = false;
+    std::remove(g_active, g_active + g_activeCount, &a);
+    if (--g_activeCount == 0) go_idle();
+    else if (!g_ticking) reschedule();
+}
+
+bool get_message(MSG& msg) {
+    for (;;) {
+        if (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
+            // A busy queue must not starve animations
+            if (g_activeCount > 0 && perf::now_ns() >= g_nextFrame)
+                tick_all();
+            return msg.message != WM_QUIT;
+        }
+        DWORD count = g_activeCount > 0 ? 1 : 0;
+        DWORD r = MsgWaitForMultipleObjectsEx(count, &g_timer, INFINITE,
+                                              QS_ALLINPUT,
+                                              MWMO_INPUTAVAILABLE);
+        g_wakeups.add();
+        if (count == 1 && r == WAIT_OBJECT_0) tick_all();
+    }
+}
+
+void shutdown() {
+    for (int i = 0; i < g_activeCount; ++i) g_active[i]->active = false;
+    g_activeCount = 0;
+    if (g_timer) {
+        go_idle();
+        CloseHandle(g_timer);
+        g_timer = nullptr;
+    }
+    g_wakeups.end();
+}
+
+}  // namespace frame_scheduler
@@ -0,0 +1,37 @@
+#pragma once
+#include <windows.h>
+#include "perf.h"
+
+// One frame clock for every animation, driven from the main message loop.
+// Active animations are ticked together off a single high-resolution
+// waitable timer, armed for the earliest one due; with none active the
+// loop blocks on messages alone.
+namespace frame_scheduler {
+
+// A per-frame callback plus the histogram its tick times go to.
+// Declare at namespace scope (it owns a perf metric).
+struct Animation {
+    Animation(const char* metric_name, void (*tick_fn)())
+        : frame_time(metric_name), tick(tick_fn) {}
+
+    perf::Histogram frame_time;
+    void (*tick)();
+    bool active = false;  // managed by start() / stop()
+    uint64_t due_ns = 0;  // managed by wake_at(); 0 = next shared frame
+};
+
+bool init();
+// First tick lands on the next shared frame; no-op if already running
+void start(Animation& a);
+// Safe to call from inside the animation's own tick
+void stop(Animation& a);
+// Next tick of a no earlier than due_ns (perf::now_ns() clock) instead of
+// the next shared frame, for animations whose picture only changes now and
+// then; 0 goes back to every frame. Typically called from a's own tick.
+void wake_at(Animation& a, uint64_t due_ns);
+// GetMessageW replacement for the main loop: runs due frames while waiting.
+// Returns false on WM_QUIT.
+bool get_message(MSG& msg);
+void shutdown();
+
+}  // namespace frame_scheduler
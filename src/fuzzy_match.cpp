@@ -0,0 +1,120 @@
+#include "fuzzy_match.h"
+#include <algorithm>
+
+namespace fuzzy_match {
+namespace {
+
+constexpr int kMatch = 16;        // every matched character
+constexpr int kWordStart = 10;    // ... at the start of a word
+constexpr int kConsecutive = 12;  // ... right after the previous match
+constexpr int kMaxGapPenalty = 24;
+constexpr int kNameBonus = 8;     // the display name outranks the caption
+
+constexpr wchar_t fold(wchar_t c) {
+    return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c - L'A' + L'a')
+                                    : c;
+}
+
+constexpr bool is_separator(wchar_t c) {
+    return c == L' ' || c == L'-' || c == L'_' || c == L'.' || c == L'/'
+        || c == L'\\' || c == L'(' || c == L'[' || c == L':';
+}
+
+bool word_start(std::wstring_view text, size_t i) {
+    if (i == 0) return true;
+    wchar_t prev = text[i - 1];
+    wchar_t cur = text[i];
+    return is_separator(prev)
+        || (prev >= L'a' && prev <= L'z' && cur >= L'A' && cur <= L'Z');
+}
+
+// Greedy match of pattern starting at text[start]; -1 if it runs out
+int score_from(std::wstring_view pattern, std::wstring_view text,
+               size_t start) {
+    int total = 0;
+    size_t prev = start;
+    size_t t = start;
+    for (size_t p = 0; p < pattern.size(); ++p, ++t) {
+        wchar_t want = fold(pattern[p]);
+        while (t < text.size() && fold(text[t]) != want) ++t;
+        if (t == text.size()) return -1;
+        total += kMatch;
+        if (word_start(text, t)) total += kWordStart;
+        if (p > 0 && t == prev + 1) total += kConsecutive;
+        prev = t;
+    }
+    int gaps = static_cast<int>(prev - start + 1 - pattern.size());
+    return total - std::min(gaps, kMaxGapPenalty);
+}
+
+}  // namespace
+
+int score(std::wstring_view pattern, std::wstring_view text) {
+    if (pattern.empty()) return 0;
+    // Best greedy run over every place the first character occurs; the
+    // first failing start means no later one can match either
+    wchar_t first = fold(pattern[0]);
+    int best = -1;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (fold(text[i]) != first) continue;
+        int s = score_from(pattern, text, i);
+        if (s < 0) break;
+        best = std::max(best, s);
+    }
+    return best;
+}
+
+void Matcher::set_candidates(std::span<const Candidate> candidates) {
+    candidates_.assign(candidates.begin(), candidates.end());
+    clear();
+}
+
+void Matcher::clear() {
+    pattern_.clear();
+    levels_.resize(1);
+    levels_[0].clear();
+    for (size_t i = 0; i < candidates_.size(); ++i)
+        levels_[0].push_back({static_cast<int>(i), 0});
+    rank();
+}
+
+int Matcher::candidate_score(const Candidate& c,
+                             std::wstring_view pattern) const {
+    int by_name = score(pattern, c.name);
+    int by_caption = score(pattern, c.caption);
+    return std::max(by_name >= 0 ? by_name + kNameBonus : -1, by_caption);
+}
+
+bool Matcher::push(wchar_t c) {
+    std::wstring next = pattern_ + c;
+    std::vector<Scored> survivors;
+    for (const auto& [i, prev_score] : levels_.back()) {
+        int s = candidate_score(candidates_[i], next);
+        if (s >= 0) survivors.push_back({i, s});
+    }
+    if (survivors.empty()) return false;
+    pattern_ = std::move(next);
+    levels_.push_back(std::move(survivors));
+    rank();
+    return true;
+}
+
+bool Matcher::pop() {
+    if (pattern_.empty()) return false;
+    pattern_.pop_back();
+    levels_.pop_back();
+    rank();
+    return true;
+}
+
+void Matcher::rank() {
+    std::vector<Scored> sorted = levels_.back();
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Scored& a, const Scored& b) {
+                         return a.second > b.second;
+                     });
+    ranked_.clear();
+    for (const auto& s : sorted) ranked_.push_back(s.first);
+}
+
+}  // namespace fuzzy_match
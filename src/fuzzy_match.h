@@ -0,0 +1,55 @@
+#pragma once
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Type-to-filter matching for the switcher. A pattern matches a text if
+// its characters appear in order (ASCII case-insensitive); the score
+// favours matches at word starts and runs of consecutive characters and
+// penalizes gaps. The Matcher narrows incrementally: each typed character
+// only re-scores the candidates that matched the pattern before it.
+namespace fuzzy_match {
+
+// Score of pattern in text, -1 if it is not a subsequence. An empty
+// pattern scores 0.
+int score(std::wstring_view pattern, std::wstring_view text);
+
+// Strings are viewed, not copied; they must outlive the Matcher's use
+struct Candidate {
+    std::wstring_view name;     // display name; matches here rank higher
+    std::wstring_view caption;  // window title
+};
+
+class Matcher {
+public:
+    // Replaces the candidates and clears the pattern
+    void set_candidates(std::span<const Candidate> candidates);
+
+    // Extend the pattern by c. False (pattern unchanged) if no candidate
+    // matches the longer pattern.
+    bool push(wchar_t c);
+    // Drop the last pattern character; false if the pattern is empty
+    bool pop();
+    void clear();
+
+    const std::wstring& pattern() const { return pattern_; }
+    // Matching candidate indices, best first; ties keep candidate order.
+    // Every candidate while the pattern is empty.
+    std::span<const int> results() const { return ranked_; }
+
+private:
+    using Scored = std::pair<int, int>;  // candidate index, score
+
+    int candidate_score(const Candidate& c, std::wstring_view pattern) const;
+    void rank();
+
+    std::vector<Candidate> candidates_;
+    std::wstring pattern_;
+    // levels_[k]: candidates matching pattern_[0, k), in candidate order
+    std::vector<std::vector<Scored>> levels_;
+    std::vector<int> ranked_;
+};
+
+}  // namespace fuzzy_match
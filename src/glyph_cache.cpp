@@ -0,0 +1,49 @@
+#include "glyph_cache.h"
+
+namespace glyph_cache {
+namespace {
+
+constexpr bool is_high_surrogate(wchar_t c) { return c >= 0xD800 && c <= 0xDBFF; }
+constexpr bool is_low_surrogate(wchar_t c) { return c >= 0xDC00 && c <= 0xDFFF; }
+
+}  // namespace
+
+void Advances::reset(MeasureFn measure, void* ctx) {
+    measure_ = measure;
+    ctx_ = ctx;
+    for (auto& p : pages_) p.reset();
+}
+
+int Advances::of(wchar_t c) {
+    auto u = static_cast<uint16_t>(c);
+    auto& page = pages_[u >> 8];
+    if (!page) {
+        page = std::make_unique<Page>();
+        page->fill(-1);
+    }
+    int16_t& w = (*page)[u & 0xFF];
+    if (w < 0) {
+        ++misses_;
+        w = static_cast<int16_t>(measure_ ? measure_(&c, 1, ctx_) : 0);
+    }
+    return w;
+}
+
+int Advances::unit_width(std::wstring_view text, size_t i, size_t& n) {
+    if (is_high_surrogate(text[i]) && i + 1 < text.size()
+        && is_low_surrogate(text[i + 1])) {
+        n = 2;
+        ++misses_;
+        return measure_ ? measure_(&text[i], 2, ctx_) : 0;
+    }
+    n = 1;
+    return of(text[i]);
+}
+
+int Advances::width(std::wstring_view text) {
+    int w = 0;
+    for (size_t i = 0, n; i < text.size(); i += n) w += unit_width(text, i, n);
+    return w;
+}
+
+}  // namespace glyph_cache
@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+// Per-character advance widths for one font, measured once and then
+// summed, so laying out a title needs no GDI call once its characters have
+// been seen. Advances are stored in lazily allocated 256-entry pages of the
+// BMP; surrogate pairs are measured as a unit on every use. Summed advances
+// match a full-string measurement for the simple (non-shaped) scripts the
+// switcher shows. The caller supplies the measurer.
+namespace glyph_cache {
+
+// Advance of text[0, len) in the target font, in pixels
+using MeasureFn = int (*)(const wchar_t* text, int len, void* ctx);
+
+class Advances {
+public:
+    // Bind to a font's measurer; drops everything cached for the old one
+    void reset(MeasureFn measure, void* ctx);
+
+    int of(wchar_t c);
+    int width(std::wstring_view text);
+
+    uint64_t misses() const { return misses_; }
+
+private:
+    using Page = std::array<int16_t, 256>;  // -1 = not measured yet
+
+    // Width of the code point starting at text[i]; n gets its unit count
+    int unit_width(std::wstring_view text, size_t i, size_t& n);
+
+    MeasureFn measure_ = nullptr;
+    void* ctx_ = nullptr;
+    std::array<std::unique_ptr<Page>, 256> pages_;
+    uint64_t misses_ = 0;
+};
+
+}  // namespace glyph_cache
@@ -1,29 +1,116 @@
 #include "hotkey.h"
+#include "keyboard_hook.h"
+#include "perf.h"
+#include <cstdio>
+#include <vector>
 
 namespace hotkey {
+namespace {
 
-bool register_all(HWND hwnd, const std::vector<Binding>& bindings) {
-    for (const auto& b : bindings) {
-        if (!RegisterHotKey(hwnd, b.id, b.modifiers, b.vk)) {
-            return false;
-        }
-    }
-    return true;
+Engine g_engine = Engine::RegisterHotKey;
+
+// Active set: table position i has id g_table.id_of(i); bindings first
+action_table::Table g_table;
+size_t g_registered = 0;  // leading table entries handed to RegisterHotKey
+
+perf::Counter g_failures{"hotkey.register_failures"};
+
+void log(const char* line) {
+#ifdef _WIN32
+    OutputDebugStringA(line);
+#endif
 }
 
-void unregister_all(HWND hwnd, const std::vector<Binding>& bindings) {
-    for (const auto& b : bindings) {
-        UnregisterHotKey(hwnd, b.id);
-    }
+void report_failure(const char* what, size_t index) {
+    g_failures.add();
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "[hotkey] %s %zu is not active\n",
+                  what, index);
+    log(buf);
+}
+
+void release(HWND hwnd) {
+    for (size_t i = 0; i < g_registered; ++i)
+        UnregisterHotKey(hwnd, g_table.id_of(i));
+    g_registered = 0;
+    keyboard_hook::stop();
+}
+
+// RegisterHotKey modifiers -> key_engine modifier bits (MOD_NOREPEAT etc.
+// have no equivalent)
+key_engine::Pattern to_pattern(const Binding& b) {
+    key_engine::Pattern p;
+    p.strokes[0].mods = static_cast<uint8_t>(
+        b.modifiers & (MOD_ALT | MOD_CONTROL | MOD_SHIFT | MOD_WIN));
+    p.strokes[0].keys[0] = static_cast<uint8_t>(b.vk);
+    return p;
 }
 
-void dispatch(WPARAM id, const std::vector<Binding>& bindings) {
-    for (const auto& b : bindings) {
-        if (b.id == static_cast<int>(id)) {
-            b.action();
-            return;
+}  // namespace
+
+void init(Engine engine) {
+    g_engine = engine;
+}
+
+bool register_all(HWND hwnd, std::span<const Binding> bindings,
+                  std::span<const Gesture> gestures) {
+    if (bindings.size() + gestures.size() > kMaxBindings) return false;
+
+    // Build the replacement table before touching the live one
+    action_table::Table next;
+    std::vector<action_table::Action> actions;
+    actions.reserve(bindings.size() + gestures.size());
+    for (const auto& b : bindings) actions.push_back(b.action);
+    for (const auto& g : gestures) actions.push_back(g.action);
+    next.assign(actions);
+
+    // Our own keys would collide with the new registrations
+    release(hwnd);
+    g_table.swap(next);
+
+    if (g_engine == Engine::KeyboardHook) {
+        std::vector<key_engine::Pattern> patterns;
+        patterns.reserve(actions.size());
+        for (const auto& b : bindings) patterns.push_back(to_pattern(b));
+        for (const auto& g : gestures) patterns.push_back(g.keys);
+        if (keyboard_hook::start(hwnd, kHookMessage, patterns)) return true;
+        log("[hotkey] keyboard hook unavailable; using RegisterHotKey\n");
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < bindings.size(); ++i) {
+        if (!RegisterHotKey(hwnd, g_table.id_of(i), bindings[i].modifiers,
+                            bindings[i].vk)) {
+            report_failure("binding", i);
+            ok = false;
         }
     }
+    g_registered = bindings.size();
+    for (size_t i = 0; i < gestures.size(); ++i) {
+        report_failure("gesture (needs the keyboard hook)", i);
+        ok = false;
+    }
+    return ok;
+}
+
+void unregister_all(HWND hwnd) {
+    release(hwnd);
+    g_table.clear();
+}
+
+bool dispatch(WPARAM id) {
+    if (id == 0 || id > g_registered) return false;
+    return g_table.dispatch(static_cast<int>(id));
+}
+
+void drain_hook() {
+    int pattern;
+    while (keyboard_hook::pop(pattern))
+        g_table.dispatch(g_table.id_of(static_cast<size_t>(pattern)));
+}
+
+void shutdown() {
+    keyboard_hook::stop();
 }
 
 }  // namespace hotkey
@@ -1,19 +1,48 @@
 #pragma once
 #include <windows.h>
-#include <functional>
-#include <vector>
+#include <span>
+#include "action_table.h"
+#include "key_engine.h"
 
 namespace hotkey {
 
+enum class Engine {
+    RegisterHotKey,  // system hotkeys; single modifier+vk combos only
+    KeyboardHook,    // WH_KEYBOARD_LL thread; adds chords and sequences
+};
+
 struct Binding {
-    int id;
     UINT modifiers;
     UINT vk;
-    std::function<void()> action;
+    action_table::Action action;
+};
+
+// Chord or leader sequence; only the KeyboardHook engine serves these
+struct Gesture {
+    key_engine::Pattern keys;
+    action_table::Action action;
 };
 
-bool register_all(HWND hwnd, const std::vector<Binding>& bindings);
-void unregister_all(HWND hwnd, const std::vector<Binding>& bindings);
-void dispatch(WPARAM id, const std::vector<Binding>& bindings);
+// Hotkey ids are assigned densely from 1 (bindings, then gestures); keep
+// other RegisterHotKey ids on the same window above kMaxBindings.
+constexpr size_t kMaxBindings = 4096;
+
+// Posted to the registration window when the keyboard hook fired
+constexpr UINT kHookMessage = WM_APP + 1;
+
+// Selects the engine later register_all() calls use
+void init(Engine engine);
+// Replaces the active set; the dispatch table is swapped in one step.
+// With the KeyboardHook engine, falls back to RegisterHotKey if the hook
+// cannot be installed. Keys that cannot be registered are skipped and
+// reported; returns false if any binding or gesture is not active.
+bool register_all(HWND hwnd, std::span<const Binding> bindings,
+                  std::span<const Gesture> gestures = {});
+void unregister_all(HWND hwnd);
+// WM_HOTKEY handler; O(1). Returns false for ids that are not bindings.
+bool dispatch(WPARAM id);
+// kHookMessage handler: runs every action the hook queued
+void drain_hook();
+void shutdown();
 
 }  // namespace hotkey
@@ -1,35 +1,26 @@
 #include "indicator.h"
+#include "frame_scheduler.h"
+#include "perf.h"
+#include "render.h"
+#include "sdf_raster.h"
 #include <cmath>
 #include <algorithm>
 #include <cstdint>
+#include <vector>
 
 namespace indicator {
 namespace {
 
 constexpr wchar_t kClassName[] = L"CustomKeypadIndicator";
-constexpr UINT_PTR kAnimTimerId = 100;
-constexpr DWORD kFrameIntervalMs = 16;  // ~60fps
 constexpr int kSize = 32;
 constexpr int kMargin = 8;
 
-// Colors (normalized 0.0-1.0)
-constexpr float kAccentR = 0.0f;
-constexpr float kAccentG = 0.831f;
-constexpr float kAccentB = 1.0f;    // #00D4FF
-
-constexpr float kBodyR = 0.102f;
-constexpr float kBodyG = 0.102f;
-constexpr float kBodyB = 0.180f;    // #1A1A2E
-
-// Animation
-constexpr float kBreathSpeed = 1.8f;  // rad/s (~3.5s cycle)
-
 HINSTANCE g_hInstance = nullptr;
 HWND g_hwnd = nullptr;
 HDC g_hdcMem = nullptr;
 HBITMAP g_hbmp = nullptr;
 uint32_t* g_pixels = nullptr;
-ULONGLONG g_startTick = 0;
+uint64_t g_startNs = 0;  // perf::now_ns() at show, for the breath phase
 
 // Drag state
 constexpr int kDragThreshold = 5;  // px to distinguish click from drag
@@ -38,10 +29,7 @@ bool g_dragging = false;
 POINT g_drag_start = {};    // screen coords at mouse down
 POINT g_window_start = {};  // window pos at mouse down
 
-// Spin animation
-constexpr float kPi = 3.14159265f;
-constexpr DWORD kSpinDurationMs = 1200;
-constexpr float kSpinRevolutions = 0.5f;
+// Spin animation (0 = not spinning)
 ULONGLONG g_spinStartTick = 0;
 
 // Fade out animation
@@ -49,34 +37,34 @@ constexpr DWORD kFadeDurationMs = 400;
 bool g_fading_out = false;
 ULONGLONG g_fadeStartTick = 0;
 
-// Signed distance to a flat-top regular hexagon centered at origin
-float sdf_hexagon(float px, float py, float r) {
-    constexpr float k = 0.8660254f;  // sqrt(3)/2
-    float ax = std::abs(px);
-    float ay = std::abs(py);
-    float d = std::max(ax * 0.5f + ay * k, ax) - r;
-    return d;
-}
-
-// Signed distance to a diamond (45-deg rotated square) centered at origin
-float sdf_diamond(float px, float py, float r) {
-    return (std::abs(px) + std::abs(py)) - r;
-}
-
-// Premultiplied alpha composite: src over dst
-void composite_over(float sr, float sg, float sb, float sa,
-                    float& dr, float& dg, float& db, float& da) {
-    float inv = 1.0f - sa;
-    dr = sr * sa + dr * inv;
-    dg = sg * sa + dg * inv;
-    db = sb * sa + db * inv;
-    da = sa + da * inv;
+// Breathing frame cache: one full frame per quantized breath phase, used
+// whenever the indicator is not spinning
+constexpr float kPi = 3.14159265f;
+constexpr size_t kFramePixels = kSize * kSize;
+constexpr int kMaxBreathFrames = 256;
+int g_breathFrames = 0;              // 0 = cache disabled
+std::vector<uint32_t> g_frames;      // g_breathFrames * kFramePixels
+int g_shownFrame = -1;               // cached frame currently uploaded
+// A large cache has more phases than 60 fps can show
+constexpr uint64_t kMinWakeNs = 16'666'667;
+BYTE g_shownAlpha = 0;
+
+perf::Load g_liveCpu{"indicator.live.cpu"};
+perf::Load g_cachedCpu{"indicator.cached.cpu"};
+perf::Gauge g_cacheBytes{"indicator.frame_cache_bytes"};
+
+void render_frame();
+frame_scheduler::Animation g_anim{"indicator.frame", render_frame};
+
+perf::Load& render_cpu() {
+    return g_breathFrames > 0 ? g_cachedCpu : g_liveCpu;
 }
 
 void do_hide() {
     if (!g_hwnd) return;
     g_fading_out = false;
-    KillTimer(g_hwnd, kAnimTimerId);
+    frame_scheduler::stop(g_anim);
+    render_cpu().end();
     if (g_hbmp) { DeleteObject(g_hbmp); g_hbmp = nullptr; }
     if (g_hdcMem) { DeleteDC(g_hdcMem); g_hdcMem = nullptr; }
     g_pixels = nullptr;
@@ -86,25 +74,34 @@ void do_hide() {
 
 void start_spin() {
     g_spinStartTick = GetTickCount64();
+    frame_scheduler::wake_at(g_anim, 0);
+}
+
+// Render every breath phase once; kept until shutdown
+void build_frame_cache() {
+    if (g_breathFrames == 0 || !g_frames.empty()) return;
+    g_frames.resize(g_breathFrames * kFramePixels);
+    for (int i = 0; i < g_breathFrames; ++i) {
+        float phase = 2.0f * kPi * i / g_breathFrames;
+        sdf_raster::render(&g_frames[i * kFramePixels], kSize,
+                           render::indicator_breath(phase), 0.0f);
+    }
+    g_cacheBytes.add(static_cast<int64_t>(g_frames.size() * sizeof(uint32_t)));
 }
 
 void render_frame() {
     if (!g_hwnd || !g_pixels) return;
+    uint64_t start = perf::now_ns();
 
     ULONGLONG now = GetTickCount64();
-    double elapsed = (now - g_startTick) / 1000.0;
-    float breath = 0.65f + 0.35f * std::sin(static_cast<float>(elapsed * kBreathSpeed));
+    uint64_t elapsed_ns = start - g_startNs;
+    uint64_t elapsed_ms = elapsed_ns / 1'000'000;
 
-    // Spin animation (ease-out cubic)
-    float spin_angle = 0.0f;
+    // Spin animation; a finished spin renders as not spinning
+    uint64_t spin_ms = render::kSpinDurationMs;
     if (g_spinStartTick > 0) {
-        float t = static_cast<float>(now - g_spinStartTick) / kSpinDurationMs;
-        if (t >= 1.0f) {
-            g_spinStartTick = 0;
-        } else {
-            float ease = 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t);
-            spin_angle = ease * kSpinRevolutions * 2.0f * kPi;
-        }
+        spin_ms = now - g_spinStartTick;
+        if (spin_ms >= render::kSpinDurationMs) g_spinStartTick = 0;
     }
 
     // Fade out animation (ease-in quadratic)
@@ -117,88 +114,49 @@ void render_frame() {
         }
         fade_alpha = 1.0f - t * t;
     }
-
-    // Precompute rotation for hexagon (+angle) and diamond (-angle)
-    float hex_cos = std::cos(spin_angle);
-    float hex_sin = std::sin(spin_angle);
-    float dia_cos = std::cos(-spin_angle);
-    float dia_sin = std::sin(-spin_angle);
-
-    float cx = kSize * 0.5f;
-    float cy = kSize * 0.5f;
-
-    for (int y = 0; y < kSize; ++y) {
-        for (int x = 0; x < kSize; ++x) {
-            float px = x + 0.5f - cx;
-            float py = y + 0.5f - cy;
-
-            // Rotated coordinates
-            float hpx = px * hex_cos - py * hex_sin;
-            float hpy = px * hex_sin + py * hex_cos;
-            float dpx = px * dia_cos - py * dia_sin;
-            float dpy = px * dia_sin + py * dia_cos;
-
-            float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
-
-            // Layer 1: Outer glow (radial, no rotation)
-            float dist = std::sqrt(px * px + py * py);
-            float glow_inner = 10.7f;
-            float glow_outer = 15.3f;
-            if (dist < glow_outer) {
-                float t = std::clamp((dist - glow_inner) / (glow_outer - glow_inner), 0.0f, 1.0f);
-                float glow_a = (1.0f - t * t) * 0.6f * breath;
-                composite_over(kAccentR, kAccentG, kAccentB, glow_a, r, g, b, a);
-            }
-
-            // Layer 2: Hexagon body (rotated)
-            float hex_d = sdf_hexagon(hpx, hpy, 12.0f);
-            float hex_a = std::clamp(-hex_d + 0.5f, 0.0f, 1.0f);
-            if (hex_a > 0.0f) {
-                composite_over(kBodyR, kBodyG, kBodyB, hex_a, r, g, b, a);
-            }
-
-            // Layer 3: Inner hexagon ring (rotated with body)
-            float ring_d = std::abs(sdf_hexagon(hpx, hpy, 10.0f)) - 0.5f;
-            float ring_a = std::clamp(-ring_d + 0.5f, 0.0f, 1.0f) * breath;
-            if (ring_a > 0.0f) {
-                composite_over(kAccentR, kAccentG, kAccentB, ring_a, r, g, b, a);
-            }
-
-            // Layer 4: Center diamond (rotated opposite)
-            float diamond_d = sdf_diamond(dpx, dpy, 4.0f);
-            float diamond_a = std::clamp(-diamond_d + 0.5f, 0.0f, 1.0f);
-            if (diamond_a > 0.0f) {
-                composite_over(kAccentR, kAccentG, kAccentB, diamond_a, r, g, b, a);
-            }
-
-            // Store as premultiplied BGRA (DIB byte order)
-            auto to_byte = [](float v) -> uint8_t {
-                return static_cast<uint8_t>(std::clamp(v * 255.0f, 0.0f, 255.0f));
-            };
-            g_pixels[y * kSize + x] =
-                (static_cast<uint32_t>(to_byte(a)) << 24) |
-                (static_cast<uint32_t>(to_byte(r)) << 16) |
-                (static_cast<uint32_t>(to_byte(g)) << 8) |
-                static_cast<uint32_t>(to_byte(b));
+    BYTE alpha = static_cast<BYTE>(fade_alpha * 255.0f);
+
+    if (g_spinStartTick == 0 && !g_frames.empty()) {
+        // Steady state: nearest cached phase, uploaded only when it changes
+        double cycles =
+            elapsed_ns / 1e9 * render::kBreathSpeed / (2.0 * kPi);
+        int frame = static_cast<int>(
+            std::fmod(cycles, 1.0) * g_breathFrames + 0.5) % g_breathFrames;
+        // Unless fading, sleep until the nearest phase moves on
+        if (!g_fading_out) {
+            double ns_per_frame =
+                1e9 * 2.0 * kPi / render::kBreathSpeed / g_breathFrames;
+            double next = std::floor(cycles * g_breathFrames + 0.5) + 0.5;
+            uint64_t due = g_startNs
+                         + static_cast<uint64_t>(std::ceil(next * ns_per_frame));
+            frame_scheduler::wake_at(g_anim,
+                                     std::max(due, start + kMinWakeNs));
         }
+        if (frame == g_shownFrame && alpha == g_shownAlpha) {
+            render_cpu().add(perf::now_ns() - start);
+            return;
+        }
+        std::copy_n(&g_frames[frame * kFramePixels], kFramePixels, g_pixels);
+        g_shownFrame = frame;
+    } else {
+        render::indicator({g_pixels, kSize, kSize, kSize}, elapsed_ms, spin_ms);
+        g_shownFrame = -1;
     }
+    g_shownAlpha = alpha;
 
     // Update layered window (SourceConstantAlpha for fade)
     POINT ptSrc = {0, 0};
     SIZE sizeWnd = {kSize, kSize};
     BLENDFUNCTION blend = {};
     blend.BlendOp = AC_SRC_OVER;
-    blend.SourceConstantAlpha = static_cast<BYTE>(fade_alpha * 255.0f);
+    blend.SourceConstantAlpha = alpha;
     blend.AlphaFormat = AC_SRC_ALPHA;
     UpdateLayeredWindow(g_hwnd, nullptr, nullptr, &sizeWnd,
                         g_hdcMem, &ptSrc, 0, &blend, ULW_ALPHA);
+    render_cpu().add(perf::now_ns() - start);
 }
 
 LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
-    if (msg == WM_TIMER && wParam == kAnimTimerId) {
-        render_frame();
-        return 0;
-    }
     if (msg == WM_LBUTTONDOWN) {
         g_mouse_down = true;
         g_dragging = false;
@@ -239,8 +197,11 @@ LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 
 }  // namespace
 
-bool init(HINSTANCE hInstance) {
+bool init(HINSTANCE hInstance, size_t frame_cache_bytes) {
     g_hInstance = hInstance;
+    g_breathFrames = static_cast<int>(std::min<size_t>(
+        frame_cache_bytes / (kFramePixels * sizeof(uint32_t)),
+        kMaxBreathFrames));
 
     WNDCLASSEXW wc = {};
     wc.cbSize = sizeof(wc);
@@ -297,24 +258,30 @@ void show() {
     SelectObject(g_hdcMem, g_hbmp);
 
     // Initial render with spin and show
-    g_startTick = GetTickCount64();
+    build_frame_cache();
+    g_shownFrame = -1;
+    render_cpu().begin();
+    g_startNs = perf::now_ns();
     start_spin();
     render_frame();
 
     ShowWindow(g_hwnd, SW_SHOWNOACTIVATE);
-    SetTimer(g_hwnd, kAnimTimerId, kFrameIntervalMs, nullptr);
+    frame_scheduler::start(g_anim);
 }
 
 void hide() {
     if (!g_hwnd || g_fading_out) return;
     g_fading_out = true;
     g_fadeStartTick = GetTickCount64();
-    // Timer keeps running to animate the fade; do_hide() called on completion
+    frame_scheduler::wake_at(g_anim, 0);
+    // Animation keeps running to animate the fade; do_hide() called on completion
 }
 
 void shutdown() {
     g_fading_out = false;
     do_hide();
+    g_cacheBytes.add(-static_cast<int64_t>(g_frames.size() * sizeof(uint32_t)));
+    g_frames = {};
     UnregisterClassW(kClassName, g_hInstance);
 }
 
@@ -1,9 +1,15 @@
 #pragma once
 #include <windows.h>
+#include <cstddef>
 
 namespace indicator {
 
-bool init(HINSTANCE hInstance);
+// Memory for pre-rendered breathing frames (4 KB each); 0 renders every
+// frame from scratch
+constexpr size_t kDefaultFrameCacheBytes = 512 * 1024;
+
+bool init(HINSTANCE hInstance,
+          size_t frame_cache_bytes = kDefaultFrameCacheBytes);
 void show();
 void hide();
 void shutdown();
@@ -0,0 +1,131 @@
+#include "key_engine.h"
+#include <algorithm>
+
+namespace key_engine {
+namespace {
+
+// Modifier bit for a modifier virtual key, 0 for anything else
+constexpr uint8_t mod_bit(uint8_t vk) {
+    switch (vk) {
+    case 0x10: case 0xA0: case 0xA1: return kShift;  // VK_(L|R)SHIFT
+    case 0x11: case 0xA2: case 0xA3: return kCtrl;   // VK_(L|R)CONTROL
+    case 0x12: case 0xA4: case 0xA5: return kAlt;    // VK_(L|R)MENU
+    case 0x5B: case 0x5C: return kWin;               // VK_LWIN, VK_RWIN
+    default: return 0;
+    }
+}
+
+int key_count(const Stroke& s) {
+    int n = 0;
+    while (n < kMaxChordKeys && s.keys[n] != 0) ++n;
+    return n;
+}
+
+}  // namespace
+
+void Engine::set_patterns(std::span<const Pattern> patterns) {
+    patterns_.assign(patterns.begin(), patterns.end());
+    lengths_.assign(patterns_.size(), 0);
+    for (size_t i = 0; i < patterns_.size(); ++i) {
+        uint8_t n = 0;
+        while (n < kMaxStrokes && patterns_[i].strokes[n].keys[0] != 0) ++n;
+        lengths_[i] = n;
+    }
+    alive_.assign(patterns_.size(), 1);
+    next_.assign(patterns_.size(), 0);
+    reset();
+}
+
+void Engine::reset() {
+    down_.reset();
+    swallowed_.reset();
+    held_keys_ = 0;
+    restart_sequence();
+}
+
+void Engine::restart_sequence() {
+    pos_ = 0;
+    std::fill(alive_.begin(), alive_.end(), 1);
+}
+
+uint8_t Engine::held_mods() const {
+    uint8_t mods = 0;
+    for (uint8_t vk : {0x10, 0xA0, 0xA1, 0x11, 0xA2, 0xA3,
+                       0x12, 0xA4, 0xA5, 0x5B, 0x5C}) {
+        if (down_[vk]) mods |= mod_bit(vk);
+    }
+    return mods;
+}
+
+Result Engine::on_key(uint8_t vk, bool down, uint32_t time_ms) {
+    Result r;
+    if (mod_bit(vk)) {
+        down_[vk] = down;
+        return r;
+    }
+
+    if (!down) {
+        if (down_[vk]) {
+            down_.reset(vk);
+            --held_keys_;
+        }
+        r.swallow = swallowed_[vk];
+        swallowed_.reset(vk);
+        return r;
+    }
+
+    // Auto-repeat follows the original key-down
+    if (down_[vk]) {
+        r.swallow = swallowed_[vk];
+        return r;
+    }
+    down_.set(vk);
+    ++held_keys_;
+
+    if (pos_ > 0 && time_ms - last_stroke_ms_ > kSequenceTimeoutMs)
+        restart_sequence();
+
+    // Compare the held set against stroke pos_ of every live pattern
+    uint8_t mods = held_mods();
+    bool advance = false;
+    bool partial = false;
+    for (size_t i = 0; i < patterns_.size(); ++i) {
+        next_[i] = 0;
+        if (!alive_[i] || pos_ >= lengths_[i]) continue;
+        const Stroke& s = patterns_[i].strokes[pos_];
+        if (s.mods != mods) continue;
+        int n = key_count(s);
+        int held = 0;
+        for (int k = 0; k < n; ++k) held += down_[s.keys[k]];
+        if (held != held_keys_) continue;  // something else is held
+
+        if (held < n) {
+            partial = true;                // chord still incomplete
+            next_[i] = 2;
+        } else if (pos_ + 1 == lengths_[i]) {
+            if (r.fired < 0) r.fired = static_cast<int>(i);
+        } else {
+            advance = true;
+            next_[i] = 1;
+        }
+    }
+
+    if (r.fired >= 0) {
+        restart_sequence();
+    } else if (advance) {
+        // Partial chords of this stroke are abandoned with the sequence step
+        for (size_t i = 0; i < alive_.size(); ++i) alive_[i] = next_[i] == 1;
+        ++pos_;
+        last_stroke_ms_ = time_ms;
+    } else if (!partial) {
+        if (pos_ == 0) return r;  // not ours
+        restart_sequence();       // wrong key ends the sequence
+    }
+
+    r.swallow = true;
+    r.mask_menu = (mods & (kAlt | kWin)) != 0;
+    swallowed_.set(vk);
+    return r;
+}
+
+}  // namespace key_engine
@@ -0,0 +1,78 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Key-event state machine for the low-level keyboard hook: matches chords
+// (several keys held together under an exact modifier set) and leader
+// sequences (strokes pressed one after another) from raw key transitions.
+// Each step is a short scan over the patterns that are still possible, no
+// allocation. Virtual-key codes and modifier bits use the Win32 values.
+namespace key_engine {
+
+// Modifier bits (same values as MOD_ALT / MOD_CONTROL / MOD_SHIFT / MOD_WIN)
+constexpr uint8_t kAlt = 0x1;
+constexpr uint8_t kCtrl = 0x2;
+constexpr uint8_t kShift = 0x4;
+constexpr uint8_t kWin = 0x8;
+
+constexpr int kMaxChordKeys = 3;
+constexpr int kMaxStrokes = 4;
+constexpr uint32_t kSequenceTimeoutMs = 1000;  // max gap between strokes
+
+// Non-modifier keys pressed together while exactly `mods` are held.
+// Unused key slots are 0.
+struct Stroke {
+    uint8_t mods = 0;
+    uint8_t keys[kMaxChordKeys] = {};
+};
+
+// One or more strokes pressed in order; unused strokes have no keys
+struct Pattern {
+    Stroke strokes[kMaxStrokes] = {};
+};
+
+struct Result {
+    bool swallow = false;    // hide this event from other applications
+    bool mask_menu = false;  // swallowed under Alt / Win: the caller should
+                             // tap a dummy key so the modifier release does
+                             // not open the menu bar / Start
+    int fired = -1;          // index of the pattern this event completed
+};
+
+// Matching rules:
+// - modifier keys always pass through and only update the held set
+// - a stroke that completes a pattern fires it, even if it is also the
+//   prefix of a longer pattern
+// - keys that may still become part of a chord or sequence are swallowed;
+//   a chord key released before the chord completes is lost
+// - inside a sequence, a key that matches nothing ends the sequence and is
+//   swallowed; so does a gap longer than kSequenceTimeoutMs
+// - the key-up (and auto-repeat) of a swallowed key-down is swallowed too
+class Engine {
+public:
+    // Replaces the patterns and resets all state
+    void set_patterns(std::span<const Pattern> patterns);
+    // One key transition; time_ms is any millisecond clock (may wrap)
+    Result on_key(uint8_t vk, bool down, uint32_t time_ms);
+    void reset();
+
+    int sequence_position() const { return pos_; }
+
+private:
+    uint8_t held_mods() const;
+    void restart_sequence();
+
+    std::vector<Pattern> patterns_;
+    std::vector<uint8_t> lengths_;  // strokes per pattern
+    std::vector<uint8_t> alive_;    // pattern still matches strokes [0, pos_)
+    std::vector<uint8_t> next_;     // scratch for the next alive_ set
+    std::bitset<256> down_;         // every key currently held
+    std::bitset<256> swallowed_;    // held keys whose key-down was swallowed
+    int held_keys_ = 0;             // non-modifier keys in down_
+    int pos_ = 0;                   // strokes of the current sequence done
+    uint32_t last_stroke_ms_ = 0;
+};
+
+}  // namespace key_engine
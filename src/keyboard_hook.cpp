@@ -0,0 +1,142 @@
+#include "keyboard_hook.h"
+#include "perf.h"
+#include "spsc_queue.h"
+#include <cstdint>
+
+namespace keyboard_hook {
+namespace {
+
+constexpr ULONG_PTR kInjectedTag = 0x4B50484B;  // marks our own mask taps
+constexpr WORD kMaskVk = 0xE8;                  // unassigned virtual key
+
+struct Fired {
+    int pattern;
+    uint64_t hook_ns;  // perf::now_ns() when the hook saw the key
+};
+
+HANDLE g_thread = nullptr;
+DWORD g_threadId = 0;
+HANDLE g_ready = nullptr;
+bool g_installed = false;  // written by the hook thread before g_ready
+HHOOK g_hook = nullptr;
+HWND g_notifyHwnd = nullptr;
+UINT g_notifyMsg = 0;
+
+// Owned by the hook thread while it runs
+key_engine::Engine g_engine;
+spsc_queue::Queue<Fired, 64> g_queue;
+
+perf::Histogram g_stepTime{"keyboard_hook.step"};
+perf::Histogram g_deliveryTime{"keyboard_hook.delivery"};
+perf::Counter g_dropped{"keyboard_hook.dropped"};
+
+// Releasing Alt / Win right after a swallowed key would open the menu bar
+// or Start; an extra key in between cancels that
+void tap_mask_key() {
+    INPUT in[2] = {};
+    for (INPUT& i : in) {
+        i.type = INPUT_KEYBOARD;
+        i.ki.wVk = kMaskVk;
+        i.ki.dwExtraInfo = kInjectedTag;
+    }
+    in[1].ki.dwFlags = KEYEVENTF_KEYUP;
+    SendInput(2, in, sizeof(INPUT));
+}
+
+// Must stay well inside the system's LowLevelHooksTimeout: one engine
+// step, a queue push and a PostMessage
+LRESULT CALLBACK hook_proc(int code, WPARAM wp, LPARAM lp) {
+    if (code != HC_ACTION) return CallNextHookEx(nullptr, code, wp, lp);
+    const auto* k = reinterpret_cast<const KBDLLHOOKSTRUCT*>(lp);
+    if (k->dwExtraInfo == kInjectedTag)
+        return CallNextHookEx(nullptr, code, wp, lp);
+
+    uint64_t start = perf::now_ns();
+    bool down = (wp == WM_KEYDOWN || wp == WM_SYSKEYDOWN);
+    key_engine::Result r = g_engine.on_key(static_cast<uint8_t>(k->vkCode),
+                                           down, k->time);
+    if (r.fired >= 0) {
+        if (g_queue.push({r.fired, start}))
+            PostMessageW(g_notifyHwnd, g_notifyMsg, 0, 0);
+        else
+            g_dropped.add();
+    }
+    if (r.mask_menu) tap_mask_key();
+    g_stepTime.record(perf::now_ns() - start);
+
+    return r.swallow ? 1 : CallNextHookEx(nullptr, code, wp, lp);
+}
+
+DWORD WINAPI thread_main(LPVOID) {
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+    g_hook = SetWindowsHookExW(WH_KEYBOARD_LL, hook_proc,
+                               GetModuleHandleW(nullptr), 0);
+
+    // Create the message queue before signalling so stop()'s WM_QUIT
+    // cannot be lost
+    MSG msg;
+    PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+    g_installed = g_hook != nullptr;
+    SetEvent(g_ready);
+    if (!g_hook) return 1;
+
+    // Low-level hooks are called from this thread's message loop
+    while (GetMessageW(&msg, nullptr, 0, 0) > 0) {
+    }
+    UnhookWindowsHookEx(g_hook);
+    g_hook = nullptr;
+    return 0;
+}
+
+}  // namespace
+
+bool start(HWND notify_hwnd, UINT notify_msg,
+           std::span<const key_engine::Pattern> patterns) {
+    stop();
+    g_engine.set_patterns(patterns);
+    g_notifyHwnd = notify_hwnd;
+    g_notifyMsg = notify_msg;
+
+    g_ready = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!g_ready) return false;
+    g_installed = false;
+    g_thread = CreateThread(nullptr, 0, thread_main, nullptr, 0, &g_threadId);
+    if (g_thread) WaitForSingleObject(g_ready, INFINITE);
+    CloseHandle(g_ready);
+    g_ready = nullptr;
+
+    if (g_thread && !g_installed) {
+        WaitForSingleObject(g_thread, INFINITE);
+        CloseHandle(g_thread);
+        g_thread = nullptr;
+    }
+    return g_thread != nullptr;
+}
+
+void stop() {
+    if (!g_thread) return;
+    PostThreadMessageW(g_threadId, WM_QUIT, 0, 0);
+    WaitForSingleObject(g_thread, INFINITE);
+    CloseHandle(g_thread);
+    g_thread = nullptr;
+    g_threadId = 0;
+
+    // Anything still queued belongs to the old pattern set
+    Fired f;
+    while (g_queue.pop(f)) {
+    }
+}
+
+bool running() {
+    return g_thread != nullptr;
+}
+
+bool pop(int& pattern) {
+    Fired f;
+    if (!g_queue.pop(f)) return false;
+    g_deliveryTime.record(perf::now_ns() - f.hook_ns);
+    pattern = f.pattern;
+    return true;
+}
+
+}  // namespace keyboard_hook
@@ -0,0 +1,20 @@
+#pragma once
+#include <windows.h>
+#include <span>
+#include "key_engine.h"
+
+// WH_KEYBOARD_LL hotkey engine. The hook runs on its own high-priority
+// thread, steps a key_engine::Engine per event and hands fired pattern
+// indices to the UI thread through a lock-free queue, posting notify_msg
+// to notify_hwnd as the wakeup.
+namespace keyboard_hook {
+
+// Replaces any running hook. False if the hook could not be installed.
+bool start(HWND notify_hwnd, UINT notify_msg,
+           std::span<const key_engine::Pattern> patterns);
+void stop();
+bool running();
+// UI thread: next fired pattern index; false once drained
+bool pop(int& pattern);
+
+}  // namespace keyboard_hook
@@ -1,10 +1,13 @@
 #include <windows.h>
-#include <vector>
 #include "hotkey.h"
 #include "indicator.h"
 #include "overlay.h"
 #include "switcher.h"
 #include "edge_flash.h"
+#include "frame_scheduler.h"
+#include "perf.h"
+#include <array>
+#include <span>
 
 #ifndef VK_F23
 #define VK_F23 0x86
@@ -24,30 +27,72 @@
 
 namespace {
 
+// KeyboardHook adds chords and leader sequences (hotkey::Gesture) at the
+// cost of a global hook; RegisterHotKey stays the default
+constexpr hotkey::Engine kHotkeyEngine = hotkey::Engine::RegisterHotKey;
+
 constexpr int kToggleHotkeyId = 9999;
+static_assert(kToggleHotkeyId > hotkey::kMaxBindings,
+              "toggle id must not collide with binding ids");
 bool g_hotkeys_active = true;
 HWND g_msg_hwnd = nullptr;
 
-const std::vector<hotkey::Binding> g_bindings = {
-    {
-        .id = 10,
-        .modifiers = MOD_ALT,
-        .vk = VK_OEM_MINUS,
-        .action = [] { switcher::toggle(); },
-    },
-    {
-        .id = 11,
-        .modifiers = MOD_ALT,
-        .vk = VK_OEM_7,
-        .action = [] { switcher::move_left(); },
-    },
-    {
-        .id = 12,
-        .modifiers = MOD_ALT,
-        .vk = VK_OEM_5,
-        .action = [] { switcher::move_right(); },
-    },
-};
+void jump_slot(intptr_t slot) {
+    switcher::jump_to(static_cast<int>(slot));
+}
+
+void jump_initial(intptr_t c) {
+    switcher::jump_to_initial(static_cast<wchar_t>(c));
+}
+
+constexpr int kSlotKeys = 10;  // Alt+1..9, Alt+0
+
+constexpr auto g_bindings = [] {
+    std::array<hotkey::Binding, 3 + kSlotKeys> b = {{
+        {
+            .modifiers = MOD_ALT,
+            .vk = VK_OEM_MINUS,
+            .action = [] { switcher::toggle(); },
+        },
+        {
+            .modifiers = MOD_ALT,
+            .vk = VK_OEM_7,
+            .action = [] { switcher::move_left(); },
+        },
+        {
+            .modifiers = MOD_ALT,
+            .vk = VK_OEM_5,
+            .action = [] { switcher::move_right(); },
+        },
+    }};
+    // Alt+N jumps to chip N; Alt+0 is the tenth
+    for (int i = 0; i < kSlotKeys; ++i) {
+        b[3 + i] = {
+            .modifiers = MOD_ALT,
+            .vk = static_cast<UINT>('0' + (i + 1) % 10),
+            .action = {jump_slot, i},
+        };
+    }
+    return b;
+}();
+
+// Alt+Space, then a letter: jump to the next window starting with it.
+// Sequences need the keyboard hook engine.
+constexpr auto g_gestures = [] {
+    std::array<hotkey::Gesture, 26> g = {};
+    for (int i = 0; i < 26; ++i) {
+        g[i].keys.strokes[0] = {key_engine::kAlt, {VK_SPACE}};
+        g[i].keys.strokes[1] = {0, {static_cast<uint8_t>('A' + i)}};
+        g[i].action = {jump_initial, 'A' + i};
+    }
+    return g;
+}();
+
+bool register_hotkeys(HWND hwnd) {
+    std::span<const hotkey::Gesture> gestures;
+    if (kHotkeyEngine == hotkey::Engine::KeyboardHook) gestures = g_gestures;
+    return hotkey::register_all(hwnd, g_bindings, gestures);
+}
 
 LRESULT CALLBACK msg_wndproc(HWND hwnd, UINT msg,
                              WPARAM wParam, LPARAM lParam) {
@@ -55,16 +100,20 @@ LRESULT CALLBACK msg_wndproc(HWND hwnd, UINT msg,
         if (wParam == kToggleHotkeyId) {
             g_hotkeys_active = !g_hotkeys_active;
             if (g_hotkeys_active) {
-                hotkey::register_all(hwnd, g_bindings);
+                register_hotkeys(hwnd);
                 indicator::show();
             } else {
-                hotkey::unregister_all(hwnd, g_bindings);
+                hotkey::unregister_all(hwnd);
                 switcher::hide();
                 indicator::hide();
             }
             return 0;
         }
-        hotkey::dispatch(wParam, g_bindings);
+        hotkey::dispatch(wParam);
+        return 0;
+    }
+    if (msg == hotkey::kHookMessage) {
+        hotkey::drain_hook();
         return 0;
     }
     return DefWindowProcW(hwnd, msg, wParam, lParam);
@@ -73,6 +122,7 @@ LRESULT CALLBACK msg_wndproc(HWND hwnd, UINT msg,
 }  // namespace
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
+    if (!frame_scheduler::init()) return 1;
     if (!overlay::init(hInstance)) return 1;
     if (!indicator::init(hInstance)) return 1;
     if (!switcher::init(hInstance)) return 1;
@@ -93,11 +143,10 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
 
     if (!g_msg_hwnd) return 1;
 
-    // Register custom hotkeys
-    if (!hotkey::register_all(g_msg_hwnd, g_bindings)) {
-        DestroyWindow(g_msg_hwnd);
-        return 1;
-    }
+    // Register custom hotkeys; a key taken by another app is reported and
+    // skipped, the rest still work
+    hotkey::init(kHotkeyEngine);
+    register_hotkeys(g_msg_hwnd);
 
     // Register Ctrl+Alt+M as toggle
     RegisterHotKey(g_msg_hwnd, kToggleHotkeyId, MOD_CONTROL | MOD_ALT, 'M');
@@ -105,9 +154,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
     // Show indicator (hotkeys start active)
     indicator::show();
 
-    // Message loop
+    // Message loop (also drives all animation frames)
     MSG msg;
-    while (GetMessageW(&msg, nullptr, 0, 0) > 0) {
+    while (frame_scheduler::get_message(msg)) {
         TranslateMessage(&msg);
         DispatchMessageW(&msg);
     }
@@ -116,8 +165,11 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
     edge_flash::shutdown();
     switcher::shutdown();
     indicator::shutdown();
+    frame_scheduler::shutdown();
     UnregisterHotKey(g_msg_hwnd, kToggleHotkeyId);
-    hotkey::unregister_all(g_msg_hwnd, g_bindings);
+    hotkey::unregister_all(g_msg_hwnd);
+    hotkey::shutdown();
     DestroyWindow(g_msg_hwnd);
+    perf::report();
     return 0;
 }
@@ -0,0 +1,62 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+
+// Fixed-capacity most-recently-used list in a ring buffer. A new key takes
+// the slot before the head, overwriting the least recent one when full; a
+// key already present moves to the front, shifting only the keys that were
+// more recent than it. Never allocates.
+namespace mru_ring {
+
+template <typename Key, size_t Capacity>
+class Ring {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be 2^n");
+
+public:
+    // Make key the most recent
+    void touch(const Key& key) {
+        size_t i = find(key);
+        if (i == size_) {
+            head_ = (head_ - 1) & (Capacity - 1);
+            if (size_ < Capacity) ++size_;
+            at(0) = key;
+            return;
+        }
+        for (; i > 0; --i) at(i) = at(i - 1);
+        at(0) = key;
+    }
+
+    void erase(const Key& key) {
+        size_t i = find(key);
+        if (i == size_) return;
+        for (; i + 1 < size_; ++i) at(i) = at(i + 1);
+        --size_;
+    }
+
+    // 0 for the most recent key, -1 if key is not in the ring
+    int rank(const Key& key) const {
+        size_t i = find(key);
+        return i == size_ ? -1 : static_cast<int>(i);
+    }
+
+    size_t size() const { return size_; }
+    const Key& operator[](size_t i) const {
+        return items_[(head_ + i) & (Capacity - 1)];
+    }
+
+private:
+    Key& at(size_t i) { return items_[(head_ + i) & (Capacity - 1)]; }
+
+    size_t find(const Key& key) const {
+        for (size_t i = 0; i < size_; ++i) {
+            if ((*this)[i] == key) return i;
+        }
+        return size_;
+    }
+
+    Key items_[Capacity] = {};
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+}  // namespace mru_ring
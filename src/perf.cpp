@@ -0,0 +1,188 @@
+#include "perf.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace perf {
+namespace {
+
+Metric* g_head = nullptr;
+
+const auto g_epoch = std::chrono::steady_clock::now();
+
+void emit(const char* line) {
+#ifdef _WIN32
+    OutputDebugStringA(line);
+#else
+    std::fputs(line, stderr);
+#endif
+}
+
+}  // namespace
+
+uint64_t now_ns() {
+    auto d = std::chrono::steady_clock::now() - g_epoch;
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()) + 1;
+}
+
+Metric::Metric(const char* name) : name_(name), next_(g_head) {
+    g_head = this;
+}
+
+void Counter::describe(char* buf, int size) const {
+    std::snprintf(buf, size, "%llu",
+                  static_cast<unsigned long long>(value()));
+}
+
+void Gauge::add(int64_t delta) {
+    int64_t v = value_.fetch_add(delta, std::memory_order_relaxed) + delta;
+    int64_t prev = peak_.load(std::memory_order_relaxed);
+    while (v > prev &&
+           !peak_.compare_exchange_weak(prev, v, std::memory_order_relaxed)) {
+    }
+}
+
+void Gauge::describe(char* buf, int size) const {
+    std::snprintf(buf, size, "%lld (peak %lld)",
+                  static_cast<long long>(value()),
+                  static_cast<long long>(peak()));
+}
+
+void Rate::begin() {
+    if (since_ns_ == 0) since_ns_ = now_ns();
+}
+
+void Rate::end() {
+    if (since_ns_ == 0) return;
+    active_ns_ += now_ns() - since_ns_;
+    since_ns_ = 0;
+}
+
+double Rate::per_minute() const {
+    uint64_t active = active_ns_;
+    if (since_ns_ != 0) active += now_ns() - since_ns_;
+    if (active == 0) return 0.0;
+    return static_cast<double>(count_.load(std::memory_order_relaxed))
+         * 60e9 / static_cast<double>(active);
+}
+
+void Rate::describe(char* buf, int size) const {
+    uint64_t active = active_ns_;
+    if (since_ns_ != 0) active += now_ns() - since_ns_;
+    std::snprintf(buf, size, "%llu over %.1f s (%.1f/min)",
+                  static_cast<unsigned long long>(
+                      count_.load(std::memory_order_relaxed)),
+                  static_cast<double>(active) / 1e9, per_minute());
+}
+
+double Ratio::value() const {
+    uint64_t base = base_.load(std::memory_order_relaxed);
+    if (base == 0) return 0.0;
+    return static_cast<double>(count_.load(std::memory_order_relaxed))
+         * static_cast<double>(per_) / static_cast<double>(base);
+}
+
+void Ratio::describe(char* buf, int size) const {
+    std::snprintf(buf, size, "%.1f per %llu (%llu over %llu)", value(),
+                  static_cast<unsigned long long>(per_),
+                  static_cast<unsigned long long>(
+                      count_.load(std::memory_order_relaxed)),
+                  static_cast<unsigned long long>(
+                      base_.load(std::memory_order_relaxed)));
+}
+
+void Load::describe(char* buf, int size) const {
+    std::snprintf(buf, size, "%.1f us/s", us_per_second());
+}
+
+namespace {
+
+// Bucket layout: values below 2^kSubBits map 1:1, above that each power of
+// two is split into 2^kSubBits linear sub-buckets
+constexpr int bucket_of(uint64_t v, int sub_bits) {
+    if (v < (uint64_t{1} << sub_bits)) return static_cast<int>(v);
+    int msb = 63 - std::countl_zero(v);
+    int sub = static_cast<int>((v >> (msb - sub_bits))
+                               & ((uint64_t{1} << sub_bits) - 1));
+    return ((msb - sub_bits + 1) << sub_bits) + sub;
+}
+
+// Midpoint of a bucket's value range
+constexpr uint64_t bucket_value(int b, int sub_bits) {
+    if (b < (1 << sub_bits)) return static_cast<uint64_t>(b);
+    int msb = (b >> sub_bits) + sub_bits - 1;
+    uint64_t sub = static_cast<uint64_t>(b & ((1 << sub_bits) - 1));
+    uint64_t lo = (uint64_t{1} << msb) | (sub << (msb - sub_bits));
+    return lo + (uint64_t{1} << (msb - sub_bits)) / 2;
+}
+
+}  // namespace
+
+void Histogram::record(uint64_t ns) {
+    buckets_[bucket_of(ns, kSubBits)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t prev = max_.load(std::memory_order_relaxed);
+    while (ns > prev &&
+           !max_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t Histogram::percentile(double p) const {
+    uint64_t n = count();
+    if (n == 0) return 0;
+    auto rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(n - 1));
+    uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += buckets_[b].load(std::memory_order_relaxed);
+        if (seen > rank) {
+            return std::min(bucket_value(b, kSubBits),
+                            max_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_.load(std::memory_order_relaxed);
+}
+
+void Histogram::describe(char* buf, int size) const {
+    uint64_t n = count();
+    double mean = n ? static_cast<double>(sum_.load(std::memory_order_relaxed))
+                      / static_cast<double>(n) : 0.0;
+    std::snprintf(buf, size,
+                  "n=%llu mean=%.1fus p50=%.1fus p90=%.1fus p99=%.1fus "
+                  "max=%.1fus",
+                  static_cast<unsigned long long>(n), mean / 1e3,
+                  static_cast<double>(percentile(50)) / 1e3,
+                  static_cast<double>(percentile(90)) / 1e3,
+                  static_cast<double>(percentile(99)) / 1e3,
+                  static_cast<double>(max_.load(std::memory_order_relaxed))
+                      / 1e3);
+}
+
+void report() {
+    char value[160];
+    char line[256];
+    for (const Metric* m = g_head; m; m = m->next_) {
+        m->describe(value, sizeof(value));
+        std::snprintf(line, sizeof(line), "[perf] %s: %s\n", m->name(), value);
+        emit(line);
+    }
+#ifdef _WIN32
+    // Leak check: these should stay flat however long the app has run
+    HANDLE self = GetCurrentProcess();
+    DWORD handles = 0;
+    GetProcessHandleCount(self, &handles);
+    std::snprintf(line, sizeof(line),
+                  "[perf] process: gdi_objects=%lu user_objects=%lu "
+                  "handles=%lu\n",
+                  GetGuiResources(self, GR_GDIOBJECTS),
+                  GetGuiResources(self, GR_USEROBJECTS), handles);
+    emit(line);
+#endif
+}
+
+}  // namespace perf
@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lightweight, allocation-free instrumentation.
+// Metrics are declared at namespace scope in the module that owns them and
+// register themselves in a static list; report() dumps all of them.
+namespace perf {
+
+// Monotonic nanoseconds since process start (never 0)
+uint64_t now_ns();
+
+class Metric {
+public:
+    explicit Metric(const char* name);
+    Metric(const Metric&) = delete;
+    Metric& operator=(const Metric&) = delete;
+
+    const char* name() const { return name_; }
+    virtual void describe(char* buf, int size) const = 0;
+
+protected:
+    ~Metric() = default;
+
+private:
+    friend void report();
+    const char* name_;
+    Metric* next_;
+};
+
+// Monotonic event count
+class Counter : public Metric {
+public:
+    using Metric::Metric;
+    void add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+    void describe(char* buf, int size) const override;
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+// Current level with high-water mark (e.g. bytes held)
+class Gauge : public Metric {
+public:
+    using Metric::Metric;
+    void add(int64_t delta);
+    int64_t value() const { return value_.load(std::memory_order_relaxed); }
+    int64_t peak() const { return peak_.load(std::memory_order_relaxed); }
+    void describe(char* buf, int size) const override;
+
+private:
+    std::atomic<int64_t> value_{0};
+    std::atomic<int64_t> peak_{0};
+};
+
+// Event count normalized by the time the source was active (events/min)
+class Rate : public Metric {
+public:
+    using Metric::Metric;
+    void begin();
+    void end();
+    void add(uint64_t n = 1) { count_.fetch_add(n, std::memory_order_relaxed); }
+    double per_minute() const;
+    void describe(char* buf, int size) const override;
+
+private:
+    std::atomic<uint64_t> count_{0};
+    uint64_t active_ns_ = 0;
+    uint64_t since_ns_ = 0;  // 0 = inactive
+};
+
+// Events per `per` occurrences of a base event (e.g. allocations per 1000
+// toggles)
+class Ratio : public Metric {
+public:
+    Ratio(const char* name, uint64_t per) : Metric(name), per_(per) {}
+    void add(uint64_t n = 1) { count_.fetch_add(n, std::memory_order_relaxed); }
+    void add_base(uint64_t n = 1) {
+        base_.fetch_add(n, std::memory_order_relaxed);
+    }
+    double value() const;
+    void describe(char* buf, int size) const override;
+
+private:
+    uint64_t per_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> base_{0};
+};
+
+// Busy time normalized by the time the source was active: add() takes
+// nanoseconds and the report is CPU microseconds per second
+class Load : public Rate {
+public:
+    using Rate::Rate;
+    double us_per_second() const { return per_minute() / 60e3; }
+    void describe(char* buf, int size) const override;
+};
+
+// Log-linear histogram of durations in nanoseconds (4 sub-buckets per
+// power of two, so percentiles are within ~12%)
+class Histogram : public Metric {
+public:
+    using Metric::Metric;
+    void record(uint64_t ns);
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t percentile(double p) const;  // p in [0, 100]
+    void describe(char* buf, int size) const override;
+
+private:
+    static constexpr int kSubBits = 2;
+    static constexpr int kBuckets = 64 << kSubBits;
+    std::atomic<uint64_t> buckets_[kBuckets] = {};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+// Records the lifetime of the scope into a histogram
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& h) : h_(h), start_(now_ns()) {}
+    ~ScopedTimer() { h_.record(now_ns() - start_); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& h_;
+    uint64_t start_;
+};
+
+// Write every registered metric to the debugger output (stderr elsewhere)
+void report();
+
+}  // namespace perf
@@ -0,0 +1,237 @@
+#include "pixel_kernels.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define PIXEL_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace pixel {
+namespace {
+
+// Exact x / 255 for any 16-bit x
+constexpr uint32_t div255(uint32_t x) {
+    return (x * 0x8081u) >> 23;
+}
+
+// ---- Scalar reference ------------------------------------------------------
+
+void set_opaque_scalar(uint32_t* px, size_t n) {
+    for (size_t i = 0; i < n; ++i) px[i] |= 0xFF000000;
+}
+
+void lerp_scalar(uint32_t* dst, const uint32_t* a, const uint32_t* b,
+                 size_t n, uint8_t t) {
+    uint32_t it = 255u - t;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t pa = a[i], pb = b[i], out = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            uint32_t ca = (pa >> shift) & 0xFF;
+            uint32_t cb = (pb >> shift) & 0xFF;
+            out |= div255(ca * it + cb * t) << shift;
+        }
+        dst[i] = out;
+    }
+}
+
+void src_over_scalar(uint32_t* dst, const uint32_t* src, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t s = src[i], d = dst[i], out = 0;
+        uint32_t inv = 255u - (s >> 24);
+        for (int shift = 0; shift < 32; shift += 8) {
+            uint32_t c = ((s >> shift) & 0xFF)
+                       + div255(((d >> shift) & 0xFF) * inv);
+            out |= (c > 255 ? 255 : c) << shift;
+        }
+        dst[i] = out;
+    }
+}
+
+constexpr Kernels kScalar = {set_opaque_scalar, lerp_scalar, src_over_scalar};
+
+#ifdef PIXEL_KERNELS_X86
+
+// ---- SSE2 (4 px per step) --------------------------------------------------
+
+inline __m128i div255_epu16(__m128i x) {
+    return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16(
+        static_cast<short>(0x8081))), 7);
+}
+
+// (a * it + b * t) / 255 on 8 unpacked channels
+inline __m128i lerp_epu16(__m128i a, __m128i b, __m128i it, __m128i t) {
+    return div255_epu16(_mm_add_epi16(_mm_mullo_epi16(a, it),
+                                      _mm_mullo_epi16(b, t)));
+}
+
+// Broadcast each pixel's alpha over its four 16-bit channels
+inline __m128i alpha_epu16(__m128i x) {
+    x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_shufflehi_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+void set_opaque_sse2(uint32_t* px, size_t n) {
+    const __m128i mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(px + i);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_loadu_si128(p), mask));
+    }
+    set_opaque_scalar(px + i, n - i);
+}
+
+void lerp_sse2(uint32_t* dst, const uint32_t* a, const uint32_t* b,
+               size_t n, uint8_t t) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vt = _mm_set1_epi16(t);
+    const __m128i vit = _mm_set1_epi16(static_cast<short>(255 - t));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i lo = lerp_epu16(_mm_unpacklo_epi8(va, zero),
+                                _mm_unpacklo_epi8(vb, zero), vit, vt);
+        __m128i hi = lerp_epu16(_mm_unpackhi_epi8(va, zero),
+                                _mm_unpackhi_epi8(vb, zero), vit, vt);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_packus_epi16(lo, hi));
+    }
+    lerp_scalar(dst + i, a + i, b + i, n - i, t);
+}
+
+void src_over_sse2(uint32_t* dst, const uint32_t* src, size_t n) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v255 = _mm_set1_epi16(255);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i vs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i vd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i slo = _mm_unpacklo_epi8(vs, zero);
+        __m128i shi = _mm_unpackhi_epi8(vs, zero);
+        __m128i ilo = _mm_sub_epi16(v255, alpha_epu16(slo));
+        __m128i ihi = _mm_sub_epi16(v255, alpha_epu16(shi));
+        __m128i dlo = div255_epu16(
+            _mm_mullo_epi16(_mm_unpacklo_epi8(vd, zero), ilo));
+        __m128i dhi = div255_epu16(
+            _mm_mullo_epi16(_mm_unpackhi_epi8(vd, zero), ihi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_adds_epu8(vs, _mm_packus_epi16(dlo, dhi)));
+    }
+    src_over_scalar(dst + i, src + i, n - i);
+}
+
+constexpr Kernels kSSE2 = {set_opaque_sse2, lerp_sse2, src_over_sse2};
+
+// ---- AVX2 (8 px per step) --------------------------------------------------
+// unpack/pack both operate per 128-bit lane, so pixel order round-trips
+
+#define PIXEL_AVX2 __attribute__((target("avx2")))
+
+PIXEL_AVX2 inline __m256i div255_epu16_avx2(__m256i x) {
+    return _mm256_srli_epi16(_mm256_mulhi_epu16(x, _mm256_set1_epi16(
+        static_cast<short>(0x8081))), 7);
+}
+
+PIXEL_AVX2 inline __m256i alpha_epu16_avx2(__m256i x) {
+    x = _mm256_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_shufflehi_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+PIXEL_AVX2 void set_opaque_avx2(uint32_t* px, size_t n) {
+    const __m256i mask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(px + i);
+        _mm256_storeu_si256(p, _mm256_or_si256(_mm256_loadu_si256(p), mask));
+    }
+    set_opaque_sse2(px + i, n - i);
+}
+
+PIXEL_AVX2 void lerp_avx2(uint32_t* dst, const uint32_t* a,
+                          const uint32_t* b, size_t n, uint8_t t) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i vt = _mm256_set1_epi16(t);
+    const __m256i vit = _mm256_set1_epi16(static_cast<short>(255 - t));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i lo = div255_epu16_avx2(_mm256_add_epi16(
+            _mm256_mullo_epi16(_mm256_unpacklo_epi8(va, zero), vit),
+            _mm256_mullo_epi16(_mm256_unpacklo_epi8(vb, zero), vt)));
+        __m256i hi = div255_epu16_avx2(_mm256_add_epi16(
+            _mm256_mullo_epi16(_mm256_unpackhi_epi8(va, zero), vit),
+            _mm256_mullo_epi16(_mm256_unpackhi_epi8(vb, zero), vt)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_packus_epi16(lo, hi));
+    }
+    lerp_sse2(dst + i, a + i, b + i, n - i, t);
+}
+
+PIXEL_AVX2 void src_over_avx2(uint32_t* dst, const uint32_t* src, size_t n) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i v255 = _mm256_set1_epi16(255);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i vs = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(src + i));
+        __m256i vd = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(dst + i));
+        __m256i slo = _mm256_unpacklo_epi8(vs, zero);
+        __m256i shi = _mm256_unpackhi_epi8(vs, zero);
+        __m256i ilo = _mm256_sub_epi16(v255, alpha_epu16_avx2(slo));
+        __m256i ihi = _mm256_sub_epi16(v255, alpha_epu16_avx2(shi));
+        __m256i dlo = div255_epu16_avx2(
+            _mm256_mullo_epi16(_mm256_unpacklo_epi8(vd, zero), ilo));
+        __m256i dhi = div255_epu16_avx2(
+            _mm256_mullo_epi16(_mm256_unpackhi_epi8(vd, zero), ihi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_adds_epu8(vs, _mm256_packus_epi16(dlo, dhi)));
+    }
+    src_over_sse2(dst + i, src + i, n - i);
+}
+
+#undef PIXEL_AVX2
+
+constexpr Kernels kAVX2 = {set_opaque_avx2, lerp_avx2, src_over_avx2};
+
+#endif  // PIXEL_KERNELS_X86
+
+}  // namespace
+
+bool supported(Isa isa) {
+    switch (isa) {
+    case Isa::Scalar:
+        return true;
+#ifdef PIXEL_KERNELS_X86
+    case Isa::SSE2:
+        return true;
+    case Isa::AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+const Kernels& kernels(Isa isa) {
+    switch (isa) {
+#ifdef PIXEL_KERNELS_X86
+    case Isa::SSE2:
+        return kSSE2;
+    case Isa::AVX2:
+        return kAVX2;
+#endif
+    default:
+        return kScalar;
+    }
+}
+
+Isa best_isa() {
+    static const Isa isa = supported(Isa::AVX2) ? Isa::AVX2
+                         : supported(Isa::SSE2) ? Isa::SSE2
+                         : Isa::Scalar;
+    return isa;
+}
+
+}  // namespace pixel
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Bulk operations on 32-bit BGRA pixels (alpha in the top byte).
+// Each kernel has a scalar reference plus SSE2 and AVX2 variants that give
+// bit-identical results; the fastest one the CPU supports is picked on
+// first use.
+namespace pixel {
+
+enum class Isa { Scalar, SSE2, AVX2 };
+
+struct Kernels {
+    // px[i] |= 0xFF000000
+    void (*set_opaque)(uint32_t* px, size_t n);
+    // dst = (a * (255 - t) + b * t) / 255 per channel; dst may alias a or b
+    void (*lerp)(uint32_t* dst, const uint32_t* a, const uint32_t* b,
+                 size_t n, uint8_t t);
+    // Premultiplied src-over: dst = src + dst * (255 - src.a) / 255
+    // per channel (saturating)
+    void (*src_over)(uint32_t* dst, const uint32_t* src, size_t n);
+};
+
+bool supported(Isa isa);
+const Kernels& kernels(Isa isa);  // Isa must be supported
+Isa best_isa();
+
+// Dispatch to the best supported implementation
+inline void set_opaque(uint32_t* px, size_t n) {
+    kernels(best_isa()).set_opaque(px, n);
+}
+inline void lerp(uint32_t* dst, const uint32_t* a, const uint32_t* b,
+                 size_t n, uint8_t t) {
+    kernels(best_isa()).lerp(dst, a, b, n, t);
+}
+inline void src_over(uint32_t* dst, const uint32_t* src, size_t n) {
+    kernels(best_isa()).src_over(dst, src, n);
+}
+
+}  // namespace pixel
@@ -0,0 +1,186 @@
+#include "render.h"
+#include "pixel_kernels.h"
+#include "sdf_raster.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace render {
+namespace {
+
+constexpr float kPi = 3.14159265f;
+constexpr float kSpinRevolutions = 0.5f;
+
+// Edge glow accent (same as the switcher selection: #008CB4)
+constexpr float kGlowR = 0.0f;
+constexpr float kGlowG = 140.0f / 255.0f;
+constexpr float kGlowB = 180.0f / 255.0f;
+
+// Copy chip i's sprite into the panel, faded in over the background by
+// p8 / 255
+void blit_chip(const Canvas& panel, const ChipSheet& sheet, int i,
+               int cursor, uint32_t p8) {
+    const Chip& chip = sheet.chips[i];
+    int layer = (i == cursor) ? sheet.layer_height : 0;
+
+    // The panel already holds the background under the chip
+    for (int y = chip.y; y < chip.y + sheet.item_height; ++y) {
+        const uint32_t* src = sheet.atlas + (layer + y) * sheet.atlas_stride
+                            + chip.x;
+        uint32_t* dst = panel.pixels + y * panel.stride + chip.x;
+        if (p8 == 255)
+            std::copy_n(src, chip.width, dst);
+        else
+            pixel::lerp(dst, dst, src, chip.width, static_cast<uint8_t>(p8));
+    }
+}
+
+// A single glow pixel (premultiplied BGRA)
+constexpr uint32_t glow_pixel(int dist) {
+    float t = static_cast<float>(dist) / kEdgeGlowWidth;
+    float s = 1.0f - t;
+    float a = s * s * s;  // cubic falloff for soft blur
+
+    auto to_byte = [](float v) -> uint32_t {
+        return static_cast<uint32_t>(v * 255.0f);
+    };
+    return (to_byte(a) << 24) |
+           (to_byte(kGlowR * a) << 16) |
+           (to_byte(kGlowG * a) << 8) |
+           to_byte(kGlowB * a);
+}
+
+// glow_pixel(d) for every distance inside the glow, and the same reversed
+// (kGlowLutRev[i] == kGlowLut[kEdgeGlowWidth - 1 - i]) for right-edge spans
+using GlowLut = std::array<uint32_t, kEdgeGlowWidth>;
+
+constexpr GlowLut kGlowLut = [] {
+    GlowLut lut{};
+    for (int d = 0; d < kEdgeGlowWidth; ++d) lut[d] = glow_pixel(d);
+    return lut;
+}();
+
+constexpr GlowLut kGlowLutRev = [] {
+    GlowLut lut{};
+    for (int i = 0; i < kEdgeGlowWidth; ++i)
+        lut[i] = kGlowLut[kEdgeGlowWidth - 1 - i];
+    return lut;
+}();
+
+}  // namespace
+
+// ---- Indicator ---------------------------------------------------------------
+
+float indicator_phase(uint64_t elapsed_ms) {
+    double elapsed = elapsed_ms / 1000.0;
+    return static_cast<float>(elapsed * kBreathSpeed);
+}
+
+float indicator_breath(float phase) {
+    return 0.65f + 0.35f * std::sin(phase);
+}
+
+float indicator_spin_angle(uint64_t spin_ms) {
+    if (spin_ms >= kSpinDurationMs) return 0.0f;
+    float t = static_cast<float>(spin_ms) / kSpinDurationMs;
+    float ease = 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t);
+    return ease * kSpinRevolutions * 2.0f * kPi;
+}
+
+void indicator(const Canvas& c, uint64_t elapsed_ms, uint64_t spin_ms) {
+    sdf_raster::render(c.pixels, c.width,
+                       indicator_breath(indicator_phase(elapsed_ms)),
+                       indicator_spin_angle(spin_ms));
+}
+
+// ---- Switcher panel ----------------------------------------------------------
+
+uint32_t switcher_intro_ms(int chip_count) {
+    return kChipAnimMs + (chip_count > 1 ? (chip_count - 1) * kChipStaggerMs
+                                         : 0);
+}
+
+int switcher_panel(const Canvas& panel, const ChipSheet& sheet, int cursor,
+                   uint64_t elapsed_ms) {
+    int n = static_cast<int>(sheet.chips.size());
+    uint32_t totalMs = switcher_intro_ms(n);
+    float global_progress =
+        std::min(static_cast<float>(elapsed_ms) / totalMs, 1.0f);
+
+    // 1. Panel background
+    for (int y = 0; y < panel.height; ++y)
+        std::fill_n(panel.pixels + y * panel.stride, panel.width,
+                    sheet.background);
+
+    // 2. Blend each cached chip with per-chip animation
+    for (int i = 0; i < n; ++i) {
+        // Per-chip progress with stagger
+        float delay = static_cast<float>(i * kChipStaggerMs) / totalMs;
+        float chipDur = static_cast<float>(kChipAnimMs) / totalMs;
+        float chip_t = std::clamp((global_progress - delay) / chipDur, 0.0f, 1.0f);
+        // Ease-out quadratic
+        float progress = 1.0f - (1.0f - chip_t) * (1.0f - chip_t);
+
+        if (progress <= 0.001f) continue;
+
+        blit_chip(panel, sheet, i, cursor,
+                  progress >= 0.999f
+                      ? 255 : static_cast<uint32_t>(progress * 255.0f));
+    }
+
+    // 3. Slide-up offset
+    float slide_t = std::clamp(global_progress * 2.0f, 0.0f, 1.0f);
+    float slide_ease = 1.0f - (1.0f - slide_t) * (1.0f - slide_t);
+    return static_cast<int>((1.0f - slide_ease) * kSlideDistance);
+}
+
+void switcher_chip(const Canvas& panel, const ChipSheet& sheet, int i,
+                   int cursor) {
+    blit_chip(panel, sheet, i, cursor, 255);
+}
+
+// ---- Edge flash --------------------------------------------------------------
+
+int edge_glow_width(int screen_w, int screen_h) {
+    return std::min(kEdgeGlowWidth, std::min(screen_w / 2, screen_h / 2));
+}
+
+// Pixel (x, y) gets glow_pixel(min(dx, dy)) where dx / dy are the distances
+// to the nearest vertical / horizontal edge, so each screen row is a left
+// ramp, a constant middle span and a mirrored right ramp.
+void edge_glow(const Canvas& c, int left, int top, int screen_w,
+               int screen_h) {
+    int sw = screen_w;
+    int sh = screen_h;
+    int gw = edge_glow_width(sw, sh);
+    int x0 = left;
+    int x1 = left + c.width;
+
+    for (int y = top; y < top + c.height; ++y) {
+        uint32_t* row = c.pixels + (y - top) * c.stride;
+        int dy = std::min(y, sh - 1 - y);
+        int ramp = std::min(dy, gw);
+        uint32_t mid = (dy < gw) ? kGlowLut[dy] : 0;
+
+        // Left ramp: screen x in [0, ramp)
+        int a = std::max(x0, 0);
+        int b = std::min(x1, ramp);
+        if (a < b)
+            std::copy(kGlowLut.begin() + a, kGlowLut.begin() + b, row + (a - x0));
+
+        // Middle: [ramp, sw - ramp)
+        a = std::max(x0, ramp);
+        b = std::min(x1, sw - ramp);
+        if (a < b) std::fill(row + (a - x0), row + (b - x0), mid);
+
+        // Right ramp: [sw - ramp, sw), value kGlowLut[sw - 1 - x]
+        a = std::max(x0, sw - ramp);
+        b = std::min(x1, sw);
+        if (a < b)
+            std::copy(kGlowLutRev.begin() + (kEdgeGlowWidth - sw + a),
+                      kGlowLutRev.begin() + (kEdgeGlowWidth - sw + b),
+                      row + (a - x0));
+    }
+}
+
+}  // namespace render
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+// Platform-neutral renderers for the indicator, switcher panel and edge
+// flash. Each fills a caller-owned premultiplied BGRA buffer for a given
+// size and animation time; the Windows modules only own the DIBs and
+// upload the result.
+namespace render {
+
+struct Canvas {
+    uint32_t* pixels;
+    int width;
+    int height;
+    int stride;  // in pixels
+};
+
+// ---- Indicator ---------------------------------------------------------------
+
+constexpr float kBreathSpeed = 1.8f;        // rad/s (~3.5s cycle)
+constexpr uint32_t kSpinDurationMs = 1200;
+
+// Breath phase (radians) after elapsed_ms
+float indicator_phase(uint64_t elapsed_ms);
+// Glow / ring intensity at a breath phase
+float indicator_breath(float phase);
+// Rotation spin_ms into a spin (ease-out cubic); 0 once it is over
+float indicator_spin_angle(uint64_t spin_ms);
+// Square canvas (width == height == stride). elapsed_ms since show,
+// spin_ms since the last spin started (>= kSpinDurationMs: not spinning).
+void indicator(const Canvas& c, uint64_t elapsed_ms, uint64_t spin_ms);
+
+// ---- Switcher panel ----------------------------------------------------------
+
+constexpr uint32_t kChipAnimMs = 400;     // each chip fade-in duration
+constexpr uint32_t kChipStaggerMs = 100;  // delay between consecutive chips
+constexpr int kSlideDistance = 8;         // px slide-up on intro
+
+// Position inside the panel
+struct Chip {
+    int x;
+    int y;
+    int width;
+};
+
+// Chip sprites for the chips on screen. The atlas is two layers of
+// layer_height rows: the first holds every chip in the normal state, the
+// second in the selected state, each at its panel position.
+struct ChipSheet {
+    const uint32_t* atlas;
+    int atlas_stride;      // in pixels
+    std::span<const Chip> chips;
+    int item_height;
+    int layer_height;      // panel height
+    uint32_t background;   // opaque panel fill
+};
+
+// Length of the intro for chip_count chips
+uint32_t switcher_intro_ms(int chip_count);
+// Whole panel elapsed_ms into the intro (>= switcher_intro_ms: final
+// frame); cursor indexes sheet.chips (-1: none shown). Returns the
+// slide-up offset for the window position.
+int switcher_panel(const Canvas& panel, const ChipSheet& sheet, int cursor,
+                   uint64_t elapsed_ms);
+// Repaint chip i fully shown (cursor moves)
+void switcher_chip(const Canvas& panel, const ChipSheet& sheet, int i,
+                   int cursor);
+
+// ---- Edge flash --------------------------------------------------------------
+
+constexpr int kEdgeGlowWidth = 40;  // px from screen edge
+
+// Glow width actually used on a screen_w x screen_h screen
+int edge_glow_width(int screen_w, int screen_h);
+// Static glow for the part of the screen the canvas covers; (left, top)
+// is the canvas origin in screen coordinates. The flash animates by
+// window alpha only.
+void edge_glow(const Canvas& c, int left, int top, int screen_w,
+               int screen_h);
+
+}  // namespace render
@@ -0,0 +1,394 @@
+#include "sdf_raster.h"
+#include <algorithm>
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define SDF_RASTER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace sdf_raster {
+namespace {
+
+// Colors (normalized 0.0-1.0)
+constexpr float kAccentR = 0.0f;
+constexpr float kAccentG = 0.831f;
+constexpr float kAccentB = 1.0f;    // #00D4FF
+
+constexpr float kBodyR = 0.102f;
+constexpr float kBodyG = 0.102f;
+constexpr float kBodyB = 0.180f;    // #1A1A2E
+
+// Geometry in kBaseSize units
+constexpr float kGlowInner = 10.7f;
+constexpr float kGlowOuter = 15.3f;
+constexpr float kHexRadius = 12.0f;
+constexpr float kRingRadius = 10.0f;
+constexpr float kRingHalfWidth = 0.5f;
+constexpr float kDiamondRadius = 4.0f;
+
+constexpr float kSqrt3Half = 0.8660254f;
+
+// Per-frame constants scaled to the target size
+struct Setup {
+    float center;
+    float hex_cos, hex_sin;   // hexagon rotation (+angle)
+    float dia_cos, dia_sin;   // diamond rotation (-angle)
+    float glow_inner, glow_range;
+    float hex_r, ring_r, ring_hw, dia_r;
+    float breath;
+};
+
+Setup make_setup(int size, float breath, float spin_angle) {
+    float scale = static_cast<float>(size) / kBaseSize;
+    Setup s;
+    s.center = size * 0.5f;
+    s.hex_cos = std::cos(spin_angle);
+    s.hex_sin = std::sin(spin_angle);
+    s.dia_cos = std::cos(-spin_angle);
+    s.dia_sin = std::sin(-spin_angle);
+    s.glow_inner = kGlowInner * scale;
+    s.glow_range = kGlowOuter * scale - s.glow_inner;
+    s.hex_r = kHexRadius * scale;
+    s.ring_r = kRingRadius * scale;
+    s.ring_hw = kRingHalfWidth * scale;
+    s.dia_r = kDiamondRadius * scale;
+    s.breath = breath;
+    return s;
+}
+
+// ---- Scalar reference ------------------------------------------------------
+
+// Signed distance to a flat-top regular hexagon centered at origin
+float sdf_hexagon(float px, float py, float r) {
+    float ax = std::abs(px);
+    float ay = std::abs(py);
+    return std::max(ax * 0.5f + ay * kSqrt3Half, ax) - r;
+}
+
+// Signed distance to a diamond (45-deg rotated square) centered at origin
+float sdf_diamond(float px, float py, float r) {
+    return (std::abs(px) + std::abs(py)) - r;
+}
+
+// Premultiplied alpha composite: src over dst
+void composite_over(float sr, float sg, float sb, float sa,
+                    float& dr, float& dg, float& db, float& da) {
+    float inv = 1.0f - sa;
+    dr = sr * sa + dr * inv;
+    dg = sg * sa + dg * inv;
+    db = sb * sa + db * inv;
+    da = sa + da * inv;
+}
+
+// Layers with zero coverage are skipped; compositing them would be an
+// exact no-op, which is what lets the vector paths run branch-free
+uint32_t shade(float px, float py, const Setup& s) {
+    float hpx = px * s.hex_cos - py * s.hex_sin;
+    float hpy = px * s.hex_sin + py * s.hex_cos;
+    float dpx = px * s.dia_cos - py * s.dia_sin;
+    float dpy = px * s.dia_sin + py * s.dia_cos;
+
+    float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+
+    // Layer 1: Outer glow (radial, no rotation)
+    float dist = std::sqrt(px * px + py * py);
+    float t = std::clamp((dist - s.glow_inner) / s.glow_range, 0.0f, 1.0f);
+    float glow_a = (1.0f - t * t) * 0.6f * s.breath;
+    if (glow_a > 0.0f)
+        composite_over(kAccentR, kAccentG, kAccentB, glow_a, r, g, b, a);
+
+    // Layer 2: Hexagon body (rotated)
+    float hex_d = sdf_hexagon(hpx, hpy, s.hex_r);
+    float hex_a = std::clamp(-hex_d + 0.5f, 0.0f, 1.0f);
+    if (hex_a > 0.0f)
+        composite_over(kBodyR, kBodyG, kBodyB, hex_a, r, g, b, a);
+
+    // Layer 3: Inner hexagon ring (rotated with body)
+    float ring_d = std::abs(sdf_hexagon(hpx, hpy, s.ring_r)) - s.ring_hw;
+    float ring_a = std::clamp(-ring_d + 0.5f, 0.0f, 1.0f) * s.breath;
+    if (ring_a > 0.0f)
+        composite_over(kAccentR, kAccentG, kAccentB, ring_a, r, g, b, a);
+
+    // Layer 4: Center diamond (rotated opposite)
+    float diamond_d = sdf_diamond(dpx, dpy, s.dia_r);
+    float diamond_a = std::clamp(-diamond_d + 0.5f, 0.0f, 1.0f);
+    if (diamond_a > 0.0f)
+        composite_over(kAccentR, kAccentG, kAccentB, diamond_a, r, g, b, a);
+
+    // Store as premultiplied BGRA (DIB byte order)
+    auto to_byte = [](float v) -> uint32_t {
+        return static_cast<uint32_t>(std::clamp(v * 255.0f, 0.0f, 255.0f));
+    };
+    return (to_byte(a) << 24) | (to_byte(r) << 16) |
+           (to_byte(g) << 8) | to_byte(b);
+}
+
+// Pixels [x0, size) of row y
+void shade_row(uint32_t* row, int y, int x0, int size, const Setup& s) {
+    float py = y + 0.5f - s.center;
+    for (int x = x0; x < size; ++x)
+        row[x] = shade(x + 0.5f - s.center, py, s);
+}
+
+void render_scalar(uint32_t* pixels, int size, const Setup& s) {
+    for (int y = 0; y < size; ++y)
+        shade_row(pixels + y * size, y, 0, size, s);
+}
+
+#ifdef SDF_RASTER_X86
+
+// ---- SSE2 (4 px per step) --------------------------------------------------
+// One register per quantity (x, y, r, g, b, a, ...), one lane per pixel
+
+inline __m128 abs_ps(__m128 v) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+inline __m128 clamp01_ps(__m128 v) {
+    return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+inline __m128 hexagon_ps(__m128 px, __m128 py, __m128 r) {
+    __m128 ax = abs_ps(px);
+    __m128 ay = abs_ps(py);
+    __m128 d = _mm_add_ps(_mm_mul_ps(ax, _mm_set1_ps(0.5f)),
+                          _mm_mul_ps(ay, _mm_set1_ps(kSqrt3Half)));
+    return _mm_sub_ps(_mm_max_ps(d, ax), r);
+}
+
+// Coverage of an SDF with a 1 px edge: clamp(0.5 - d, 0, 1)
+inline __m128 coverage_ps(__m128 d) {
+    return clamp01_ps(_mm_sub_ps(_mm_set1_ps(0.5f), d));
+}
+
+struct Rgba4 {
+    __m128 r, g, b, a;
+};
+
+inline void over_ps(Rgba4& d, float sr, float sg, float sb, __m128 sa) {
+    __m128 inv = _mm_sub_ps(_mm_set1_ps(1.0f), sa);
+    d.r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(sr), sa), _mm_mul_ps(d.r, inv));
+    d.g = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(sg), sa), _mm_mul_ps(d.g, inv));
+    d.b = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(sb), sa), _mm_mul_ps(d.b, inv));
+    d.a = _mm_add_ps(sa, _mm_mul_ps(d.a, inv));
+}
+
+inline __m128i to_byte_ps(__m128 v) {
+    v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, _mm_set1_ps(255.0f)),
+                              _mm_setzero_ps()),
+                   _mm_set1_ps(255.0f));
+    return _mm_cvttps_epi32(v);
+}
+
+void render_sse2(uint32_t* pixels, int size, const Setup& s) {
+    const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 hex_cos = _mm_set1_ps(s.hex_cos);
+    const __m128 hex_sin = _mm_set1_ps(s.hex_sin);
+    const __m128 dia_cos = _mm_set1_ps(s.dia_cos);
+    const __m128 dia_sin = _mm_set1_ps(s.dia_sin);
+    const __m128 breath = _mm_set1_ps(s.breath);
+    const int vec_end = size & ~3;
+
+    for (int y = 0; y < size; ++y) {
+        uint32_t* row = pixels + y * size;
+        const __m128 py = _mm_set1_ps(y + 0.5f - s.center);
+        for (int x = 0; x < vec_end; x += 4) {
+            __m128 px = _mm_sub_ps(
+                _mm_add_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(x)),
+                                      lane),
+                           _mm_set1_ps(0.5f)),
+                _mm_set1_ps(s.center));
+
+            __m128 hpx = _mm_sub_ps(_mm_mul_ps(px, hex_cos),
+                                    _mm_mul_ps(py, hex_sin));
+            __m128 hpy = _mm_add_ps(_mm_mul_ps(px, hex_sin),
+                                    _mm_mul_ps(py, hex_cos));
+            __m128 dpx = _mm_sub_ps(_mm_mul_ps(px, dia_cos),
+                                    _mm_mul_ps(py, dia_sin));
+            __m128 dpy = _mm_add_ps(_mm_mul_ps(px, dia_sin),
+                                    _mm_mul_ps(py, dia_cos));
+
+            Rgba4 c = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(),
+                       _mm_setzero_ps()};
+
+            __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(px, px),
+                                                 _mm_mul_ps(py, py)));
+            __m128 t = clamp01_ps(_mm_div_ps(
+                _mm_sub_ps(dist, _mm_set1_ps(s.glow_inner)),
+                _mm_set1_ps(s.glow_range)));
+            __m128 glow_a = _mm_mul_ps(
+                _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(t, t)),
+                           _mm_set1_ps(0.6f)),
+                breath);
+            over_ps(c, kAccentR, kAccentG, kAccentB, glow_a);
+
+            __m128 hex_a = coverage_ps(
+                hexagon_ps(hpx, hpy, _mm_set1_ps(s.hex_r)));
+            over_ps(c, kBodyR, kBodyG, kBodyB, hex_a);
+
+            __m128 ring_d = _mm_sub_ps(
+                abs_ps(hexagon_ps(hpx, hpy, _mm_set1_ps(s.ring_r))),
+                _mm_set1_ps(s.ring_hw));
+            over_ps(c, kAccentR, kAccentG, kAccentB,
+                    _mm_mul_ps(coverage_ps(ring_d), breath));
+
+            __m128 diamond_d = _mm_sub_ps(_mm_add_ps(abs_ps(dpx), abs_ps(dpy)),
+                                          _mm_set1_ps(s.dia_r));
+            over_ps(c, kAccentR, kAccentG, kAccentB, coverage_ps(diamond_d));
+
+            __m128i out = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(to_byte_ps(c.a), 24),
+                             _mm_slli_epi32(to_byte_ps(c.r), 16)),
+                _mm_or_si128(_mm_slli_epi32(to_byte_ps(c.g), 8),
+                             to_byte_ps(c.b)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), out);
+        }
+        shade_row(row, y, vec_end, size, s);
+    }
+}
+
+// ---- AVX2 (8 px per step) --------------------------------------------------
+
+#define SDF_AVX2 __attribute__((target("avx2")))
+
+SDF_AVX2 inline __m256 abs_ps(__m256 v) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+}
+
+SDF_AVX2 inline __m256 clamp01_ps(__m256 v) {
+    return _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()),
+                         _mm256_set1_ps(1.0f));
+}
+
+SDF_AVX2 inline __m256 hexagon_ps(__m256 px, __m256 py, __m256 r) {
+    __m256 ax = abs_ps(px);
+    __m256 ay = abs_ps(py);
+    __m256 d = _mm256_add_ps(_mm256_mul_ps(ax, _mm256_set1_ps(0.5f)),
+                             _mm256_mul_ps(ay, _mm256_set1_ps(kSqrt3Half)));
+    return _mm256_sub_ps(_mm256_max_ps(d, ax), r);
+}
+
+SDF_AVX2 inline __m256 coverage_ps(__m256 d) {
+    return clamp01_ps(_mm256_sub_ps(_mm256_set1_ps(0.5f), d));
+}
+
+struct Rgba8 {
+    __m256 r, g, b, a;
+};
+
+SDF_AVX2 inline void over_ps(Rgba8& d, float sr, float sg, float sb,
+                             __m256 sa) {
+    __m256 inv = _mm256_sub_ps(_mm256_set1_ps(1.0f), sa);
+    d.r = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(sr), sa),
+                        _mm256_mul_ps(d.r, inv));
+    d.g = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(sg), sa),
+                        _mm256_mul_ps(d.g, inv));
+    d.b = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(sb), sa),
+                        _mm256_mul_ps(d.b, inv));
+    d.a = _mm256_add_ps(sa, _mm256_mul_ps(d.a, inv));
+}
+
+SDF_AVX2 inline __m256i to_byte_ps(__m256 v) {
+    v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v, _mm256_set1_ps(255.0f)),
+                                    _mm256_setzero_ps()),
+                      _mm256_set1_ps(255.0f));
+    return _mm256_cvttps_epi32(v);
+}
+
+SDF_AVX2 void render_avx2(uint32_t* pixels, int size, const Setup& s) {
+    const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f,
+                                       4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 hex_cos = _mm256_set1_ps(s.hex_cos);
+    const __m256 hex_sin = _mm256_set1_ps(s.hex_sin);
+    const __m256 dia_cos = _mm256_set1_ps(s.dia_cos);
+    const __m256 dia_sin = _mm256_set1_ps(s.dia_sin);
+    const __m256 breath = _mm256_set1_ps(s.breath);
+    const int vec_end = size & ~7;
+
+    for (int y = 0; y < size; ++y) {
+        uint32_t* row = pixels + y * size;
+        const __m256 py = _mm256_set1_ps(y + 0.5f - s.center);
+        for (int x = 0; x < vec_end; x += 8) {
+            __m256 px = _mm256_sub_ps(
+                _mm256_add_ps(
+                    _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), lane),
+                    _mm256_set1_ps(0.5f)),
+                _mm256_set1_ps(s.center));
+
+            __m256 hpx = _mm256_sub_ps(_mm256_mul_ps(px, hex_cos),
+                                       _mm256_mul_ps(py, hex_sin));
+            __m256 hpy = _mm256_add_ps(_mm256_mul_ps(px, hex_sin),
+                                       _mm256_mul_ps(py, hex_cos));
+            __m256 dpx = _mm256_sub_ps(_mm256_mul_ps(px, dia_cos),
+                                       _mm256_mul_ps(py, dia_sin));
+            __m256 dpy = _mm256_add_ps(_mm256_mul_ps(px, dia_sin),
+                                       _mm256_mul_ps(py, dia_cos));
+
+            Rgba8 c = {_mm256_setzero_ps(), _mm256_setzero_ps(),
+                       _mm256_setzero_ps(), _mm256_setzero_ps()};
+
+            __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(px, px),
+                                                       _mm256_mul_ps(py, py)));
+            __m256 t = clamp01_ps(_mm256_div_ps(
+                _mm256_sub_ps(dist, _mm256_set1_ps(s.glow_inner)),
+                _mm256_set1_ps(s.glow_range)));
+            __m256 glow_a = _mm256_mul_ps(
+                _mm256_mul_ps(
+                    _mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(t, t)),
+                    _mm256_set1_ps(0.6f)),
+                breath);
+            over_ps(c, kAccentR, kAccentG, kAccentB, glow_a);
+
+            __m256 hex_a = coverage_ps(
+                hexagon_ps(hpx, hpy, _mm256_set1_ps(s.hex_r)));
+            over_ps(c, kBodyR, kBodyG, kBodyB, hex_a);
+
+            __m256 ring_d = _mm256_sub_ps(
+                abs_ps(hexagon_ps(hpx, hpy, _mm256_set1_ps(s.ring_r))),
+                _mm256_set1_ps(s.ring_hw));
+            over_ps(c, kAccentR, kAccentG, kAccentB,
+                    _mm256_mul_ps(coverage_ps(ring_d), breath));
+
+            __m256 diamond_d = _mm256_sub_ps(
+                _mm256_add_ps(abs_ps(dpx), abs_ps(dpy)),
+                _mm256_set1_ps(s.dia_r));
+            over_ps(c, kAccentR, kAccentG, kAccentB, coverage_ps(diamond_d));
+
+            __m256i out = _mm256_or_si256(
+                _mm256_or_si256(_mm256_slli_epi32(to_byte_ps(c.a), 24),
+                                _mm256_slli_epi32(to_byte_ps(c.r), 16)),
+                _mm256_or_si256(_mm256_slli_epi32(to_byte_ps(c.g), 8),
+                                to_byte_ps(c.b)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + x), out);
+        }
+        shade_row(row, y, vec_end, size, s);
+    }
+}
+
+#undef SDF_AVX2
+
+#endif  // SDF_RASTER_X86
+
+}  // namespace
+
+void render(uint32_t* pixels, int size, float breath, float spin_angle,
+            pixel::Isa isa) {
+    Setup s = make_setup(size, breath, spin_angle);
+    switch (isa) {
+#ifdef SDF_RASTER_X86
+    case pixel::Isa::SSE2:
+        render_sse2(pixels, size, s);
+        return;
+    case pixel::Isa::AVX2:
+        render_avx2(pixels, size, s);
+        return;
+#endif
+    default:
+        render_scalar(pixels, size, s);
+        return;
+    }
+}
+
+}  // namespace sdf_raster
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include "pixel_kernels.h"
+
+// Rasterizer for the indicator emblem: radial glow, hexagon body, hexagon
+// ring and center diamond, composited into premultiplied BGRA.
+// Geometry is defined on a 32 px grid and scaled to the target size while
+// the anti-aliased edge stays 1 px wide, so 64 / 128 px HiDPI sizes look
+// the same as 32 px. The SSE2 (4 px) and AVX2 (8 px) paths evaluate a row
+// of lanes at once and match the scalar path.
+namespace sdf_raster {
+
+constexpr int kBaseSize = 32;
+
+// Render size x size pixels (stride = size). breath scales the glow and
+// ring; the hexagon turns by +spin_angle and the diamond by -spin_angle.
+// isa must be supported (see pixel::supported).
+void render(uint32_t* pixels, int size, float breath, float spin_angle,
+            pixel::Isa isa);
+
+inline void render(uint32_t* pixels, int size, float breath,
+                   float spin_angle) {
+    render(pixels, size, breath, spin_angle, pixel::best_isa());
+}
+
+}  // namespace sdf_raster
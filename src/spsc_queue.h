@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+// Bounded lock-free single-producer / single-consumer ring buffer.
+// push() may only be called from one thread and pop() from one other
+// thread; neither blocks or allocates.
+namespace spsc_queue {
+
+template <typename T, size_t Capacity>
+class Queue {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be 2^n");
+
+public:
+    // Producer side; false if the queue is full
+    bool push(const T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == Capacity)
+            return false;
+        items_[head & (Capacity - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false if the queue is empty
+    bool pop(T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return false;
+        item = items_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Separate cache lines so the two threads do not false-share
+    alignas(64) std::atomic<size_t> head_{0};  // written by producer
+    alignas(64) std::atomic<size_t> tail_{0};  // written by consumer
+    T items_[Capacity] = {};
+};
+
+}  // namespace spsc_queue
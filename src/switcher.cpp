@@ -1,12 +1,22 @@
 #include "switcher.h"
 #include "indicator.h"
 #include "edge_flash.h"
+#include "chip_layout.h"
+#include "frame_scheduler.h"
+#include "fuzzy_match.h"
+#include "glyph_cache.h"
+#include "mru_ring.h"
+#include "perf.h"
+#include "pixel_kernels.h"
+#include "render.h"
+#include "window_model.h"
+#include <array>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <cstdint>
-#include <cwctype>
-#include <unordered_map>
 #include <algorithm>
+#include <iterator>
 
 namespace switcher {
 namespace {
@@ -20,6 +30,7 @@ constexpr int kItemPaddingY = 4;    // vertical padding inside each chip
 constexpr int kItemSpacing = 2;     // gap between chips
 constexpr int kPanelPaddingX = 4;   // panel-level horizontal padding
 constexpr int kPanelPaddingY = 3;   // panel-level vertical padding
+constexpr int kMaxPanelWidth = 960;  // chips beyond it wrap into lines
 constexpr int kFontSize = 13;
 constexpr int kMaxTitleLen = 24;
 
@@ -31,39 +42,114 @@ constexpr COLORREF kTextColor = RGB(255, 255, 255);
 
 // Animation
 constexpr UINT_PTR kFocusTimerId = 1;
-constexpr UINT_PTR kAnimTimerId = 2;
 constexpr DWORD kFocusPollMs = 100;
-constexpr DWORD kAnimFrameMs = 16;    // ~60 fps
-constexpr DWORD kChipAnimMs = 400;    // each chip fade-in duration
-constexpr DWORD kChipStaggerMs = 100; // delay between consecutive chips
-constexpr int kSlideDistance = 8;     // px slide-up on intro
 constexpr DWORD kFadeOutMs = 300;
 constexpr BYTE kPanelAlpha = 230;     // steady-state SourceConstantAlpha
 
-enum class AnimState { IDLE, INTRO, VISIBLE, FADEOUT };
+// Focus debouncing: the highlight moves at once, the foreground switch
+// waits until the hotkey modifiers are released or moves stop for
+// kFocusSettleMs, whichever comes first
+constexpr ULONGLONG kFocusSettleMs = 150;
 
-struct WindowEntry {
-    HWND hwnd;
-    std::wstring title;
-};
+// Posted by window_model's async rebuild to g_msgHwnd
+constexpr UINT kModelMessage = WM_APP + 2;
 
-struct ChipLayout {
-    std::wstring text;
-    int x;
-    int width;
-};
+// Jump-by-initial buckets: 0-9 and A-Z
+constexpr int kInitials = 36;
+
+// Type-to-filter keys, registered on g_msgHwnd from when the panel opens
+// until the modifiers are released: Alt+A..Z extend the pattern,
+// Alt+Backspace shortens it
+constexpr int kFilterLetterId = 1;  // + 0..25
+constexpr int kFilterBackId = kFilterLetterId + 26;
+constexpr int kMaxCaptionLen = 256;
+
+// Foreground history kept for MRU ordering; older windows keep enumeration
+// order after these
+constexpr size_t kRecentWindows = 128;
+
+enum class AnimState { IDLE, INTRO, VISIBLE, FADEOUT };
+
+using WindowEntry = window_model::Entry;
 
 HINSTANCE g_hInstance = nullptr;
+// Panel window. Prewarmed: created by init and kept (hidden, zero alpha)
+// between uses; otherwise created per open and destroyed after fade-out.
 HWND g_hwnd = nullptr;
-HDC g_hdcMem = nullptr;
-HBITMAP g_hbmp = nullptr;
-uint32_t* g_pixels = nullptr;
+bool g_prewarm = false;
+HWND g_msgHwnd = nullptr;  // message-only; lives from init to shutdown
+
+// A memory DC with a top-down 32-bit DIB selected into it. Kept across
+// toggles and hides; it only grows (doubling), so a panel that fits the
+// current capacity costs no GDI allocation.
+struct Surface {
+    HDC hdc = nullptr;
+    HBITMAP hbmp = nullptr;
+    HGDIOBJ oldBmp = nullptr;  // hdc's stock bitmap, selected back on release
+    uint32_t* pixels = nullptr;
+    int width = 0;   // capacity; also the row stride
+    int height = 0;
+};
+
+Surface g_panelDib;
+
+// Chip sprites rasterized once per layout / scroll (see render::ChipSheet)
+Surface g_atlasDib;
 
+std::vector<WindowEntry> g_allWindows;  // snapshot of window_model
+uint64_t g_windowsVersion = 0;
+// The chips: the entries of g_allWindows matching the filter, best first
+// (all of them while it is empty)
 std::vector<WindowEntry> g_windows;
 int g_cursor = -1;
 
-// Layout cache
-std::vector<ChipLayout> g_chips;
+// Filter over g_allWindows names and captions; captions are read on the
+// first filter key after a snapshot
+fuzzy_match::Matcher g_matcher;
+std::vector<std::wstring> g_captions;
+bool g_candidatesReady = false;
+bool g_filterKeys = false;
+
+// Per-initial chains over g_windows, rebuilt with each snapshot: the first
+// chip with an initial, and from each chip the next one sharing it
+std::array<int, kInitials> g_firstByInitial;
+std::vector<int> g_nextByInitial;
+
+// Foreground history, updated on every focus change, and the copy the
+// open panel is ordered by (so chips do not move under the cursor)
+using RecentWindows = mru_ring::Ring<HWND, kRecentWindows>;
+RecentWindows g_recent;
+RecentWindows g_openRecent;
+
+// Pending debounced focus change
+bool g_focusPending = false;
+ULONGLONG g_lastFocusRequest = 0;
+
+// Process-lifetime text resources: the chip font, a memory DC it stays
+// selected into for measuring, and per-glyph advances in that font
+HFONT g_font = nullptr;
+HDC g_hdcMeasure = nullptr;
+int g_textHeight = 0;
+glyph_cache::Advances g_advances;
+
+// Display text and width per full title; titles that did not change since
+// the previous layout are not measured again
+struct MeasuredTitle {
+    std::wstring display;
+    int width = 0;
+    uint64_t generation = 0;  // last layout that used it
+};
+std::unordered_map<std::wstring, MeasuredTitle> g_titles;
+uint64_t g_layoutGeneration = 0;
+
+// Layout cache: text and width of every chip, their lines, and the panel
+// positions of the chips in the visible lines (g_chips[i] is chip
+// g_layout.first_visible() + i). Only visible chips are rasterized.
+int g_maxRows = 1;
+std::vector<std::wstring> g_chipText;
+std::vector<int> g_chipWidths;
+chip_layout::Layout g_layout;
+std::vector<render::Chip> g_chips;
 int g_itemHeight = 0;
 int g_panelW = 0;
 int g_panelH = 0;
@@ -73,80 +159,76 @@ POINT g_panelPos = {};
 AnimState g_state = AnimState::IDLE;
 ULONGLONG g_animStart = 0;
 
-// Window class names to exclude (our own windows)
-constexpr const wchar_t* kExcludeClasses[] = {
-    L"CustomKeypadIndicator",
-    L"CustomKeypadOverlay",
-    L"CustomKeypadSwitcher",
-    L"CustomKeypadMsg",
-    L"CustomKeypadEdgeFlash",
-};
-
-// Process names to exclude from the window list
-constexpr const wchar_t* kExcludeProcesses[] = {
-    L"TextInputHost",
-    L"ApplicationFrameHost",
-    L"SystemSettings",
-};
-
-// Exe name -> friendly display name mapping
-struct NameMapping {
-    const wchar_t* exe_lower;
-    const wchar_t* display;
-};
-
-constexpr NameMapping kFriendlyNames[] = {
-    {L"code", L"VS Code"},
-    {L"msedge", L"Edge"},
-    {L"chrome", L"Chrome"},
-    {L"firefox", L"Firefox"},
-    {L"explorer", L"Explorer"},
-    {L"windowsterminal", L"Terminal"},
-    {L"wt", L"Terminal"},
-    {L"cmd", L"CMD"},
-    {L"powershell", L"PowerShell"},
-    {L"pwsh", L"PowerShell"},
-    {L"notepad", L"Notepad"},
-    {L"slack", L"Slack"},
-    {L"discord", L"Discord"},
-    {L"msteams", L"Teams"},
-};
-
-std::wstring get_display_name(HWND hwnd) {
-    DWORD pid = 0;
-    GetWindowThreadProcessId(hwnd, &pid);
-    if (pid == 0) return L"";
-
-    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
-    if (!hProcess) return L"";
-
-    wchar_t path[MAX_PATH] = {};
-    DWORD pathLen = MAX_PATH;
-    BOOL ok = QueryFullProcessImageNameW(hProcess, 0, path, &pathLen);
-    CloseHandle(hProcess);
-
-    if (!ok) return L"";
-
-    std::wstring fullPath(path, pathLen);
-    size_t lastSlash = fullPath.find_last_of(L'\\');
-    std::wstring filename = (lastSlash != std::wstring::npos)
-        ? fullPath.substr(lastSlash + 1) : fullPath;
-
-    size_t dotPos = filename.find_last_of(L'.');
-    if (dotPos != std::wstring::npos) {
-        filename = filename.substr(0, dotPos);
-    }
-
-    std::wstring lower = filename;
-    for (auto& c : lower) c = static_cast<wchar_t>(towlower(c));
+// Toggled while the model was still empty: open once the rebuild delivers
+bool g_openWhenReady = false;
+uint64_t g_toggleStartNs = 0;  // hotkey dispatch time of the pending open
+
+// Window tracking. Hidden, event mode only follows focus, minimizes and
+// destroys (idle hooks); the open panel adds creates, shows / hides and
+// renames (open hooks), and the model is resynced on every open.
+// poll_wakeups and event_wakeups both count while the panel is shown, so
+// the two modes compare; idle_event_wakeups counts while it is hidden.
+TrackingMode g_tracking = TrackingMode::Poll;
+HWINEVENTHOOK g_idleHooks[3] = {};
+HWINEVENTHOOK g_openHooks[3] = {};
+perf::Rate g_pollWakeups{"switcher.tracking.poll_wakeups"};
+perf::Rate g_eventWakeups{"switcher.tracking.event_wakeups"};
+perf::Rate g_idleEventWakeups{"switcher.tracking.idle_event_wakeups"};
+perf::Histogram g_snapshotTime{"switcher.toggle.snapshot"};
+// Hotkey to first shown frame, split by whether the window had to be
+// created first
+perf::Histogram g_firstPixelCold{"switcher.toggle.first_pixel.cold"};
+perf::Histogram g_firstPixelWarm{"switcher.toggle.first_pixel.warm"};
+perf::Histogram g_windowCreateTime{"switcher.window_create"};
+perf::Histogram g_layoutTime{"switcher.layout"};
+perf::Counter g_titlesMeasured{"switcher.layout.titles_measured"};
+perf::Counter g_focusRequests{"switcher.focus.requests"};
+perf::Counter g_focusApplied{"switcher.focus.applied"};
+perf::Counter g_focusAvoided{"switcher.focus.avoided"};
+perf::Histogram g_filterTime{"switcher.filter"};  // key to repainted panel
+
+// Rendering cost: full frames vs. cursor-move dirty updates
+perf::Histogram g_fullRenderTime{"switcher.render.frame"};
+perf::Counter g_fullRenderBytes{"switcher.render.frame_bytes"};
+perf::Histogram g_dirtyRenderTime{"switcher.render.cursor_dirty"};
+perf::Counter g_dirtyRenderBytes{"switcher.render.cursor_dirty_bytes"};
+
+// Surface pool: allocations should stay near zero per toggle once warm.
+// Every long-lived GDI object (surfaces, font, measuring DC) is counted
+// and only a successful delete takes it off again, so a failed delete
+// leaves the gauge above 0 at shutdown. test_switcher_gdi checks the
+// process's real GDI count.
+perf::Ratio g_dibAllocs{"switcher.dib.allocations", 1000};
+perf::Gauge g_gdiObjects{"switcher.gdi_objects"};
+
+// Intro and fade-out run on the shared frame clock
+void tick_anim();
+frame_scheduler::Animation g_anim{"switcher.anim.frame", tick_anim};
+
+// So does the modifier watch that settles focus changes and ends filter
+// sessions; it only runs while one of them is pending
+void tick_settle();
+frame_scheduler::Animation g_settle{"switcher.settle.frame", tick_settle};
+
+void update_settle() {
+    if (g_focusPending || g_filterKeys)
+        frame_scheduler::start(g_settle);
+    else
+        frame_scheduler::stop(g_settle);
+}
 
-    for (const auto& mapping : kFriendlyNames) {
-        if (lower == mapping.exe_lower) {
-            return mapping.display;
-        }
-    }
+void delete_object(HGDIOBJ obj) {
+    if (DeleteObject(obj))
+        g_gdiObjects.add(-1);
+    else
+        OutputDebugStringA("[switcher] DeleteObject failed\n");
+}
 
-    return filename;
+void delete_dc(HDC hdc) {
+    if (DeleteDC(hdc))
+        g_gdiObjects.add(-1);
+    else
+        OutputDebugStringA("[switcher] DeleteDC failed\n");
 }
 
 HFONT create_font() {
@@ -160,234 +242,351 @@ HFONT create_font() {
         L"Meiryo");
 }
 
-BOOL CALLBACK enum_callback(HWND hwnd, LPARAM lParam) {
-    auto* windows = reinterpret_cast<std::vector<WindowEntry>*>(lParam);
-
-    if (!IsWindowVisible(hwnd)) return TRUE;
-    if (IsIconic(hwnd)) return TRUE;
+int measure_text(const wchar_t* text, int len, void*) {
+    SIZE sz = {};
+    GetTextExtentPoint32W(g_hdcMeasure, text, len, &sz);
+    return sz.cx;
+}
 
-    int len = GetWindowTextLengthW(hwnd);
-    if (len == 0) return TRUE;
+bool create_text_resources() {
+    g_font = create_font();
+    HDC hdcScreen = GetDC(nullptr);
+    g_hdcMeasure = CreateCompatibleDC(hdcScreen);
+    ReleaseDC(nullptr, hdcScreen);
+    g_gdiObjects.add((g_font != nullptr) + (g_hdcMeasure != nullptr));
+    if (!g_font || !g_hdcMeasure) return false;
+
+    SelectObject(g_hdcMeasure, g_font);
+    TEXTMETRICW tm = {};
+    GetTextMetricsW(g_hdcMeasure, &tm);
+    g_textHeight = tm.tmHeight;
+    g_advances.reset(measure_text, nullptr);
+    return true;
+}
 
-    LONG_PTR exStyle = GetWindowLongPtrW(hwnd, GWL_EXSTYLE);
-    if (exStyle & WS_EX_TOOLWINDOW) return TRUE;
+void free_text_resources() {
+    g_advances.reset(nullptr, nullptr);
+    g_titles.clear();
+    // The font is selected into the measuring DC; the DC goes first
+    if (g_hdcMeasure) {
+        delete_dc(g_hdcMeasure);
+        g_hdcMeasure = nullptr;
+    }
+    if (g_font) {
+        delete_object(g_font);
+        g_font = nullptr;
+    }
+}
 
-    HWND owner = GetWindow(hwnd, GW_OWNER);
-    if (owner != nullptr && !(exStyle & WS_EX_APPWINDOW)) return TRUE;
+// Chip text and width for a title, from the title cache or the advances
+const MeasuredTitle& measure_title(const std::wstring& title) {
+    MeasuredTitle& m = g_titles[title];
+    if (m.generation == 0) {
+        g_titlesMeasured.add();
+        std::wstring_view shown = title;
+        bool cut = shown.size() > kMaxTitleLen;
+        if (cut) shown = shown.substr(0, kMaxTitleLen - 3);
+        m.display.assign(shown);
+        m.width = g_advances.width(shown);
+        if (cut) {
+            m.display += L"...";
+            m.width += 3 * g_advances.of(L'.');
+        }
+    }
+    m.generation = g_layoutGeneration;
+    return m;
+}
 
-    wchar_t cls[128] = {};
-    GetClassNameW(hwnd, cls, 128);
-    for (const auto* exc : kExcludeClasses) {
-        if (std::wstring_view(cls) == exc) return TRUE;
+int find_window(HWND hwnd) {
+    for (int i = 0; i < static_cast<int>(g_windows.size()); ++i) {
+        if (g_windows[i].hwnd == hwnd) return i;
     }
+    return -1;
+}
 
-    std::wstring display = get_display_name(hwnd);
+// Bucket for a title's first character, -1 if it has none
+int initial_of(wchar_t c) {
+    if (c >= L'0' && c <= L'9') return c - L'0';
+    if (c >= L'a' && c <= L'z') c = static_cast<wchar_t>(c - L'a' + L'A');
+    if (c >= L'A' && c <= L'Z') return 10 + (c - L'A');
+    return -1;
+}
 
-    for (const auto* exc : kExcludeProcesses) {
-        if (display == exc) return TRUE;
-    }
-    if (display.empty()) {
-        std::wstring title(len + 1, L'\0');
-        GetWindowTextW(hwnd, title.data(), len + 1);
-        title.resize(len);
-        display = std::move(title);
+int initial_at(int i) {
+    const std::wstring& t = g_windows[i].title;
+    return t.empty() ? -1 : initial_of(t[0]);
+}
+
+void index_initials() {
+    g_firstByInitial.fill(-1);
+    g_nextByInitial.assign(g_windows.size(), -1);
+    std::array<int, kInitials> last;
+    last.fill(-1);
+    for (int i = 0; i < static_cast<int>(g_windows.size()); ++i) {
+        int b = initial_at(i);
+        if (b < 0) continue;
+        if (last[b] < 0)
+            g_firstByInitial[b] = i;
+        else
+            g_nextByInitial[last[b]] = i;
+        last[b] = i;
     }
+}
 
-    windows->push_back({hwnd, std::move(display)});
-    return TRUE;
+// Most recently focused first (as of the panel opening); ties keep the
+// model's order
+void order_by_recency() {
+    std::vector<std::pair<int, int>> keyed;  // rank, model index
+    keyed.reserve(g_allWindows.size());
+    for (int i = 0; i < static_cast<int>(g_allWindows.size()); ++i) {
+        int rank = g_openRecent.rank(g_allWindows[i].hwnd);
+        keyed.push_back({rank < 0 ? static_cast<int>(kRecentWindows) : rank, i});
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<WindowEntry> sorted;
+    sorted.reserve(g_allWindows.size());
+    for (const auto& [rank, i] : keyed)
+        sorted.push_back(std::move(g_allWindows[i]));
+    g_allWindows = std::move(sorted);
+    g_candidatesReady = false;
 }
 
-void enumerate_windows() {
-    g_windows.clear();
-    g_cursor = -1;
-    EnumWindows(enum_callback, reinterpret_cast<LPARAM>(&g_windows));
+// Point the matcher at the current snapshot, re-applying the pattern typed
+// so far (as much of it as still matches)
+void ensure_candidates() {
+    if (g_candidatesReady) return;
+    g_candidatesReady = true;
+
+    // Other processes' captions are read without sending them a message
+    g_captions.assign(g_allWindows.size(), std::wstring());
+    std::vector<fuzzy_match::Candidate> candidates;
+    candidates.reserve(g_allWindows.size());
+    wchar_t buf[kMaxCaptionLen];
+    for (size_t i = 0; i < g_allWindows.size(); ++i) {
+        int len = GetWindowTextW(g_allWindows[i].hwnd, buf, kMaxCaptionLen);
+        g_captions[i].assign(buf, std::max(len, 0));
+        candidates.push_back({g_allWindows[i].name, g_captions[i]});
+    }
+    std::wstring pattern = g_matcher.pattern();
+    g_matcher.set_candidates(candidates);
+    for (wchar_t c : pattern) {
+        if (!g_matcher.push(c)) break;
+    }
+}
 
-    // Disambiguate duplicate titles
-    std::unordered_map<std::wstring, int> counts;
-    for (const auto& w : g_windows) counts[w.title]++;
+// Rebuild g_windows from the filter results; the cursor stays on its
+// window, or goes to the best match if that was filtered out
+void select_matches() {
+    HWND cur = (g_cursor >= 0) ? g_windows[g_cursor].hwnd : nullptr;
+    if (g_matcher.pattern().empty()) {
+        g_windows = g_allWindows;
+    } else {
+        g_windows.clear();
+        for (int i : g_matcher.results()) g_windows.push_back(g_allWindows[i]);
+    }
+    g_cursor = cur ? find_window(cur) : -1;
+    if (g_cursor < 0 && !g_matcher.pattern().empty()) g_cursor = 0;
+    index_initials();
+}
 
-    std::unordered_map<std::wstring, int> seen;
-    for (auto& w : g_windows) {
-        if (counts[w.title] > 1) {
-            int idx = ++seen[w.title];
-            w.title += L" (" + std::to_wstring(idx) + L")";
-        }
+void register_filter_keys() {
+    if (g_filterKeys) return;
+    g_filterKeys = true;
+    // A key another app holds just cannot be typed into the filter
+    for (int i = 0; i < 26; ++i) {
+        RegisterHotKey(g_msgHwnd, kFilterLetterId + i, MOD_ALT | MOD_NOREPEAT,
+                       'A' + i);
     }
+    RegisterHotKey(g_msgHwnd, kFilterBackId, MOD_ALT, VK_BACK);
+    update_settle();
+}
+
+void unregister_filter_keys() {
+    if (!g_filterKeys) return;
+    g_filterKeys = false;
+    for (int id = kFilterLetterId; id <= kFilterBackId; ++id)
+        UnregisterHotKey(g_msgHwnd, id);
+    update_settle();
 }
 
-void free_bitmap() {
-    if (g_hbmp) { DeleteObject(g_hbmp); g_hbmp = nullptr; }
-    if (g_hdcMem) { DeleteDC(g_hdcMem); g_hdcMem = nullptr; }
-    g_pixels = nullptr;
+void release(Surface& s) {
+    // A bitmap still selected into a DC cannot be deleted
+    if (s.oldBmp) SelectObject(s.hdc, s.oldBmp);
+    if (s.hbmp) delete_object(s.hbmp);
+    if (s.hdc) delete_dc(s.hdc);
+    s = {};
 }
 
-void create_bitmap(int w, int h) {
-    free_bitmap();
+// Make s at least w x h, reallocating only if it is too small
+bool reserve(Surface& s, int w, int h) {
+    if (s.pixels && w <= s.width && h <= s.height) return true;
+    int cap_w = w <= s.width ? s.width : std::max(w, s.width * 2);
+    int cap_h = h <= s.height ? s.height : std::max(h, s.height * 2);
+    release(s);
 
     HDC hdcScreen = GetDC(nullptr);
-    g_hdcMem = CreateCompatibleDC(hdcScreen);
+    s.hdc = CreateCompatibleDC(hdcScreen);
     ReleaseDC(nullptr, hdcScreen);
+    if (!s.hdc) return false;
+    g_gdiObjects.add(1);
 
     BITMAPINFO bmi = {};
     bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bmi.bmiHeader.biWidth = w;
-    bmi.bmiHeader.biHeight = -h;  // top-down
+    bmi.bmiHeader.biWidth = cap_w;
+    bmi.bmiHeader.biHeight = -cap_h;  // top-down
     bmi.bmiHeader.biPlanes = 1;
     bmi.bmiHeader.biBitCount = 32;
     bmi.bmiHeader.biCompression = BI_RGB;
 
     void* bits = nullptr;
-    g_hbmp = CreateDIBSection(g_hdcMem, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
-    g_pixels = static_cast<uint32_t*>(bits);
-    SelectObject(g_hdcMem, g_hbmp);
+    s.hbmp = CreateDIBSection(s.hdc, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (!s.hbmp) {
+        release(s);
+        return false;
+    }
+    g_gdiObjects.add(1);
+    g_dibAllocs.add();
+    s.oldBmp = SelectObject(s.hdc, s.hbmp);
+    s.pixels = static_cast<uint32_t*>(bits);
+    s.width = cap_w;
+    s.height = cap_h;
+    return true;
 }
 
-// Compute layout metrics (text measurement + positions)
-void compute_layout() {
-    HDC hdcScreen = GetDC(nullptr);
-    HFONT font = create_font();
-    HFONT oldFont = reinterpret_cast<HFONT>(SelectObject(hdcScreen, font));
-
+// Panel positions of the chips in the visible lines
+void place_visible_chips() {
     g_chips.clear();
-    int total_width = kPanelPaddingX * 2;
-    int text_height = 0;
+    for (int i = g_layout.first_visible(); i < g_layout.end_visible(); ++i) {
+        g_chips.push_back({
+            kPanelPaddingX + g_layout.x(i),
+            kPanelPaddingY + g_layout.view_line(i) * (g_itemHeight + kItemSpacing),
+            g_chipWidths[i],
+        });
+    }
+}
+
+// Compute layout metrics (text measurement + positions); the viewport
+// starts on the cursor's line
+void compute_layout() {
+    perf::ScopedTimer timer(g_layoutTime);
+    ++g_layoutGeneration;
 
+    g_chipText.clear();
+    g_chipWidths.clear();
     for (const auto& w : g_windows) {
-        std::wstring display = w.title;
-        if (display.size() > kMaxTitleLen) {
-            display = display.substr(0, kMaxTitleLen - 3) + L"...";
-        }
-        SIZE sz;
-        GetTextExtentPoint32W(hdcScreen, display.c_str(),
-                              static_cast<int>(display.size()), &sz);
-        if (sz.cy > text_height) text_height = sz.cy;
-        int item_w = sz.cx + kItemPaddingX * 2;
-        total_width += item_w;
-        g_chips.push_back({std::move(display), 0, item_w});
-    }
-    if (!g_chips.empty()) {
-        total_width += kItemSpacing * (static_cast<int>(g_chips.size()) - 1);
+        const MeasuredTitle& m = measure_title(w.title);
+        g_chipText.push_back(m.display);
+        g_chipWidths.push_back(m.width + kItemPaddingX * 2);
     }
 
-    SelectObject(hdcScreen, oldFont);
-    DeleteObject(font);
-    ReleaseDC(nullptr, hdcScreen);
+    // Forget titles no longer on screen
+    std::erase_if(g_titles, [](const auto& kv) {
+        return kv.second.generation != g_layoutGeneration;
+    });
 
-    g_itemHeight = text_height + kItemPaddingY * 2;
-    g_panelH = g_itemHeight + kPanelPaddingY * 2;
-    g_panelW = total_width;
+    // Position relative to the indicator; the width left on the work area
+    // caps the lines
+    RECT workArea;
+    SystemParametersInfoW(SPI_GETWORKAREA, 0, &workArea, 0);
+    RECT ind = indicator::get_rect();
+    bool has_indicator = !(ind.right == 0 && ind.bottom == 0);
+    int panel_x = has_indicator ? ind.right + kGap : workArea.left + 40;
+    int max_width = std::min<int>(kMaxPanelWidth, workArea.right - panel_x - kGap)
+                  - kPanelPaddingX * 2;
+
+    g_itemHeight = g_textHeight + kItemPaddingY * 2;
+    g_layout.build(g_chipWidths, max_width, g_maxRows, kItemSpacing);
+    g_layout.scroll_to(g_cursor);
+    place_visible_chips();
+
+    int rows = g_layout.visible_lines();
+    g_panelW = g_layout.width() + kPanelPaddingX * 2;
+    g_panelH = rows * g_itemHeight + (rows - 1) * kItemSpacing
+             + kPanelPaddingY * 2;
+
+    int panel_y = has_indicator
+        ? (ind.top + ind.bottom) / 2 - g_panelH / 2
+        : workArea.bottom - g_panelH - 8;
+    g_panelPos = {panel_x, std::min<int>(panel_y, workArea.bottom - g_panelH)};
+}
 
-    // X positions
-    int x = kPanelPaddingX;
-    for (auto& cl : g_chips) {
-        cl.x = x;
-        x += cl.width + kItemSpacing;
-    }
+constexpr uint32_t to_pixel(COLORREF c) {
+    return 0xFF000000 | (GetRValue(c) << 16) | (GetGValue(c) << 8)
+         | GetBValue(c);
+}
 
-    // Final position (relative to indicator)
-    RECT ind = indicator::get_rect();
-    int ind_center_y = (ind.top + ind.bottom) / 2;
-    g_panelPos = {ind.right + kGap, ind_center_y - g_panelH / 2};
-
-    if (ind.right == 0 && ind.bottom == 0) {
-        RECT workArea;
-        SystemParametersInfoW(SPI_GETWORKAREA, 0, &workArea, 0);
-        g_panelPos = {workArea.left + 40, workArea.bottom - g_panelH - 8};
-    }
-}
-
-// Render one frame. progress: 0.0 (start of intro) to 1.0 (fully visible)
-void render_frame(float global_progress) {
-    if (!g_hwnd || !g_pixels || g_chips.empty()) return;
-
-    int n = static_cast<int>(g_chips.size());
-
-    // 1. Draw panel background
-    HBRUSH bgBrush = CreateSolidBrush(kBgColor);
-    RECT full = {0, 0, g_panelW, g_panelH};
-    FillRect(g_hdcMem, &full, bgBrush);
-    DeleteObject(bgBrush);
-
-    // Fix bg alpha
-    for (int i = 0; i < g_panelW * g_panelH; ++i)
-        g_pixels[i] |= 0xFF000000;
-
-    // 2. Draw each chip with per-chip animation
-    SetBkMode(g_hdcMem, TRANSPARENT);
-    SetTextColor(g_hdcMem, kTextColor);
-    HFONT font = create_font();
-    HFONT oldF = reinterpret_cast<HFONT>(SelectObject(g_hdcMem, font));
-
-    // Compute total intro time for stagger scaling
-    DWORD totalMs = kChipAnimMs + (n > 1 ? (n - 1) * kChipStaggerMs : 0);
-
-    for (int i = 0; i < n; ++i) {
-        // Per-chip progress with stagger
-        float delay = static_cast<float>(i * kChipStaggerMs) / totalMs;
-        float chipDur = static_cast<float>(kChipAnimMs) / totalMs;
-        float chip_t = std::clamp((global_progress - delay) / chipDur, 0.0f, 1.0f);
-        // Ease-out quadratic
-        float progress = 1.0f - (1.0f - chip_t) * (1.0f - chip_t);
-
-        if (progress <= 0.001f) continue;
-
-        auto& cl = g_chips[i];
-        RECT chip = {cl.x, kPanelPaddingY,
-                     cl.x + cl.width, kPanelPaddingY + g_itemHeight};
-
-        // Save background pixels before chip drawing
-        int cw = chip.right - chip.left;
-        int ch = chip.bottom - chip.top;
-        std::vector<uint32_t> bg_saved(cw * ch);
-        for (int cy = 0; cy < ch; ++cy)
-            for (int cx = 0; cx < cw; ++cx)
-                bg_saved[cy * cw + cx] =
-                    g_pixels[(chip.top + cy) * g_panelW + chip.left + cx];
-
-        // Draw chip rect + text
-        COLORREF color = (i == g_cursor) ? kSelectedColor : kChipColor;
-        HBRUSH chipBrush = CreateSolidBrush(color);
-        FillRect(g_hdcMem, &chip, chipBrush);
-        DeleteObject(chipBrush);
-        DrawTextW(g_hdcMem, cl.text.c_str(), -1, &chip,
-                  DT_CENTER | DT_VCENTER | DT_SINGLELINE);
-
-        // Blend chip over saved bg with per-chip progress
-        if (progress >= 0.999f) {
-            for (int cy = 0; cy < ch; ++cy)
-                for (int cx = 0; cx < cw; ++cx)
-                    g_pixels[(chip.top + cy) * g_panelW + chip.left + cx] |=
-                        0xFF000000;
-        } else {
-            uint32_t p8 = static_cast<uint32_t>(progress * 255.0f);
-            uint32_t ip8 = 255 - p8;
-            for (int cy = 0; cy < ch; ++cy) {
-                for (int cx = 0; cx < cw; ++cx) {
-                    uint32_t bg = bg_saved[cy * cw + cx];
-                    uint32_t& pixel =
-                        g_pixels[(chip.top + cy) * g_panelW + chip.left + cx];
-                    uint32_t bR = (bg >> 16) & 0xFF;
-                    uint32_t bG = (bg >> 8) & 0xFF;
-                    uint32_t bB = bg & 0xFF;
-                    uint32_t cR = (pixel >> 16) & 0xFF;
-                    uint32_t cG = (pixel >> 8) & 0xFF;
-                    uint32_t cB = pixel & 0xFF;
-                    uint32_t fR = (bR * ip8 + cR * p8) / 255;
-                    uint32_t fG = (bG * ip8 + cG * p8) / 255;
-                    uint32_t fB = (bB * ip8 + cB * p8) / 255;
-                    pixel = 0xFF000000 | (fR << 16) | (fG << 8) | fB;
-                }
-            }
+constexpr uint32_t kBgPixel = to_pixel(kBgColor);
+
+// Rasterize the visible chips in both states into the atlas (needs layout
+// + DIB)
+void build_atlas() {
+    int h = g_panelH * 2;
+    if (!reserve(g_atlasDib, g_panelW, h)) return;
+    HDC hdc = g_atlasDib.hdc;
+
+    SetBkMode(hdc, TRANSPARENT);
+    SetTextColor(hdc, kTextColor);
+    HFONT oldF = reinterpret_cast<HFONT>(SelectObject(hdc, g_font));
+    HBRUSH brushes[2] = {CreateSolidBrush(kChipColor),
+                         CreateSolidBrush(kSelectedColor)};
+
+    int first = g_layout.first_visible();
+    for (int layer = 0; layer < 2; ++layer) {
+        for (size_t i = 0; i < g_chips.size(); ++i) {
+            const auto& cl = g_chips[i];
+            int top = layer * g_panelH + cl.y;
+            RECT rc = {cl.x, top, cl.x + cl.width, top + g_itemHeight};
+            FillRect(hdc, &rc, brushes[layer]);
+            DrawTextW(hdc, g_chipText[first + i].c_str(), -1, &rc,
+                      DT_CENTER | DT_VCENTER | DT_SINGLELINE);
         }
     }
 
-    SelectObject(g_hdcMem, oldF);
-    DeleteObject(font);
+    DeleteObject(brushes[0]);
+    DeleteObject(brushes[1]);
+    SelectObject(hdc, oldF);
+    GdiFlush();
+
+    // GDI leaves alpha at 0; sprites are opaque
+    pixel::set_opaque(g_atlasDib.pixels,
+                      static_cast<size_t>(g_atlasDib.width) * h);
+}
+
+// i indexes g_chips
+RECT chip_rect(int i) {
+    const auto& cl = g_chips[i];
+    return {cl.x, cl.y, cl.x + cl.width, cl.y + g_itemHeight};
+}
+
+// The cursor as an index into g_chips, -1 if scrolled out
+int view_cursor() {
+    return g_layout.visible(g_cursor) ? g_cursor - g_layout.first_visible()
+                                      : -1;
+}
+
+render::Canvas panel_canvas() {
+    return {g_panelDib.pixels, g_panelW, g_panelH, g_panelDib.width};
+}
+
+render::ChipSheet chip_sheet() {
+    return {g_atlasDib.pixels, g_atlasDib.width, g_chips, g_itemHeight,
+            g_panelH, kBgPixel};
+}
+
+uint32_t intro_ms() {
+    return render::switcher_intro_ms(static_cast<int>(g_chips.size()));
+}
+
+// Render one frame elapsed_ms into the intro (>= intro length: final frame)
+void render_frame(uint64_t elapsed_ms) {
+    if (!g_hwnd || !g_panelDib.pixels || !g_atlasDib.pixels || g_chips.empty())
+        return;
+    perf::ScopedTimer timer(g_fullRenderTime);
+    g_fullRenderBytes.add(static_cast<uint64_t>(g_panelW) * g_panelH * 4);
 
-    // 3. Position with slide-up offset
-    float slide_t = std::clamp(global_progress * 2.0f, 0.0f, 1.0f);
-    float slide_ease = 1.0f - (1.0f - slide_t) * (1.0f - slide_t);
-    int dy = static_cast<int>((1.0f - slide_ease) * kSlideDistance);
+    int dy = render::switcher_panel(panel_canvas(), chip_sheet(),
+                                    view_cursor(), elapsed_ms);
 
     POINT ptDst = {g_panelPos.x, g_panelPos.y + dy};
     SIZE sizeWnd = {g_panelW, g_panelH};
@@ -397,218 +596,601 @@ void render_frame(float global_progress) {
     blend.SourceConstantAlpha = kPanelAlpha;
     blend.AlphaFormat = AC_SRC_ALPHA;
     UpdateLayeredWindow(g_hwnd, nullptr, &ptDst, &sizeWnd,
-                        g_hdcMem, &ptSrc, 0, &blend, ULW_ALPHA);
+                        g_panelDib.hdc, &ptSrc, 0, &blend, ULW_ALPHA);
+}
+
+// Repaint only the chips whose selection state changed (VISIBLE state)
+void render_cursor_change(int prev, int next) {
+    if (!g_hwnd || !g_panelDib.pixels || !g_atlasDib.pixels || g_chips.empty())
+        return;
+    perf::ScopedTimer timer(g_dirtyRenderTime);
+
+    RECT dirty = {g_panelW, g_panelH, 0, 0};
+    for (int index : {prev, next}) {
+        if (!g_layout.visible(index)) continue;
+        int i = index - g_layout.first_visible();
+        render::switcher_chip(panel_canvas(), chip_sheet(), i, view_cursor());
+        RECT chip = chip_rect(i);
+        g_dirtyRenderBytes.add(static_cast<uint64_t>(chip.right - chip.left)
+                               * (chip.bottom - chip.top) * 4);
+        dirty.left = std::min(dirty.left, chip.left);
+        dirty.top = std::min(dirty.top, chip.top);
+        dirty.right = std::max(dirty.right, chip.right);
+        dirty.bottom = std::max(dirty.bottom, chip.bottom);
+    }
+    if (dirty.left >= dirty.right) return;
+
+    SIZE sizeWnd = {g_panelW, g_panelH};
+    POINT ptSrc = {0, 0};
+    BLENDFUNCTION blend = {};
+    blend.BlendOp = AC_SRC_OVER;
+    blend.SourceConstantAlpha = kPanelAlpha;
+    blend.AlphaFormat = AC_SRC_ALPHA;
+    UPDATELAYEREDWINDOWINFO info = {};
+    info.cbSize = sizeof(info);
+    info.psize = &sizeWnd;
+    info.hdcSrc = g_panelDib.hdc;
+    info.pptSrc = &ptSrc;
+    info.pblend = &blend;
+    info.dwFlags = ULW_ALPHA;
+    info.prcDirty = &dirty;
+    UpdateLayeredWindowIndirect(g_hwnd, &info);
+}
+
+// Re-rasterize after the viewport scrolled; the panel size is unchanged
+void show_viewport() {
+    place_visible_chips();
+    build_atlas();
+    if (g_state == AnimState::VISIBLE)
+        render_frame(intro_ms());
+}
+
+// Move the highlight; VISIBLE repaints the two affected chips (or the
+// whole panel if it had to scroll), INTRO picks the new cursor up on its
+// next frame
+void set_cursor(int i) {
+    if (g_cursor == i) return;
+    int prev = g_cursor;
+    g_cursor = i;
+    if (g_layout.scroll_to(i)) {
+        show_viewport();
+        return;
+    }
+    if (g_state == AnimState::VISIBLE)
+        render_cursor_change(prev, i);
+}
+
+bool install_open_hooks();
+void remove_open_hooks();
+
+// Follow focus and window list changes while the panel is shown
+void start_tracking() {
+    if (g_tracking == TrackingMode::Event && !install_open_hooks())
+        g_tracking = TrackingMode::Poll;
+    if (g_tracking != TrackingMode::Poll) return;
+    SetTimer(g_hwnd, kFocusTimerId, kFocusPollMs, nullptr);
+    g_pollWakeups.begin();
+}
+
+void stop_tracking() {
+    KillTimer(g_hwnd, kFocusTimerId);
+    g_pollWakeups.end();
+    remove_open_hooks();
+}
+
+bool create_panel_window() {
+    perf::ScopedTimer timer(g_windowCreateTime);
+    constexpr DWORD exStyle = WS_EX_TOPMOST | WS_EX_TOOLWINDOW
+                            | WS_EX_NOACTIVATE | WS_EX_LAYERED;
+    g_hwnd = CreateWindowExW(
+        exStyle, kClassName, L"",
+        WS_POPUP,
+        0, 0, 0, 0,
+        nullptr, nullptr, g_hInstance, nullptr);
+    return g_hwnd != nullptr;
+}
+
+// Re-blend the current panel contents at alpha a (fade-out)
+void present_alpha(BYTE a) {
+    POINT ptSrc = {0, 0};
+    SIZE sizeWnd = {g_panelW, g_panelH};
+    BLENDFUNCTION blend = {};
+    blend.BlendOp = AC_SRC_OVER;
+    blend.SourceConstantAlpha = a;
+    blend.AlphaFormat = AC_SRC_ALPHA;
+    UpdateLayeredWindow(g_hwnd, nullptr, nullptr, &sizeWnd,
+                        g_panelDib.hdc, &ptSrc, 0, &blend, ULW_ALPHA);
 }
 
 void do_hide() {
     if (g_hwnd) {
-        KillTimer(g_hwnd, kAnimTimerId);
-        KillTimer(g_hwnd, kFocusTimerId);
-        DestroyWindow(g_hwnd);
-        g_hwnd = nullptr;
+        frame_scheduler::stop(g_anim);
+        frame_scheduler::stop(g_settle);
+        stop_tracking();
+        if (g_prewarm) {
+            present_alpha(0);
+            ShowWindow(g_hwnd, SW_HIDE);
+        } else {
+            DestroyWindow(g_hwnd);
+            g_hwnd = nullptr;
+        }
     }
-    free_bitmap();
+    unregister_filter_keys();
+    g_allWindows.clear();
     g_windows.clear();
+    g_captions.clear();
+    g_candidatesReady = false;
+    g_matcher.clear();
+    g_nextByInitial.clear();
+    g_chipText.clear();
+    g_chipWidths.clear();
+    g_layout.build({}, 0, g_maxRows, 0);
     g_chips.clear();
     g_cursor = -1;
+    g_focusPending = false;
     g_state = AnimState::IDLE;
 }
 
 void focus_current() {
+    g_focusPending = false;
     if (g_cursor < 0 || g_cursor >= static_cast<int>(g_windows.size())) return;
     HWND target = g_windows[g_cursor].hwnd;
     if (!IsWindow(target)) return;
 
     if (IsIconic(target)) ShowWindow(target, SW_RESTORE);
     SetForegroundWindow(target);
+    g_recent.touch(target);
     edge_flash::flash();
+    g_focusApplied.add();
 }
 
-void sync_cursor_to_foreground() {
+bool modifiers_held() {
+    for (int vk : {VK_MENU, VK_CONTROL, VK_SHIFT, VK_LWIN, VK_RWIN}) {
+        if (GetAsyncKeyState(vk) & 0x8000) return true;
+    }
+    return false;
+}
+
+// Focus the cursor's window once the user stops moving; a move that
+// arrives while one is pending replaces it
+void request_focus() {
+    g_focusRequests.add();
+    g_lastFocusRequest = GetTickCount64();
+    if (g_focusPending) {
+        g_focusAvoided.add();
+        return;
+    }
+    g_focusPending = true;
+    update_settle();
+    if (!g_settle.active) focus_current();  // no frame clock: no debounce
+}
+
+void apply_pending_focus() {
+    if (!g_focusPending) return;
+    focus_current();
+    update_settle();
+}
+
+void tick_settle() {
+    bool held = modifiers_held();
+    // Filter letters are typed with the modifier still down; once it is
+    // let go, Alt+letters belong to other applications again
+    if (!held) unregister_filter_keys();
+    if (!held || GetTickCount64() - g_lastFocusRequest >= kFocusSettleMs)
+        apply_pending_focus();
+}
+
+void sync_cursor_to_foreground(HWND fg) {
     if (!g_hwnd || g_windows.empty()) return;
     if (g_state == AnimState::FADEOUT) return;
+    if (g_focusPending) return;  // the cursor is ahead of the foreground
 
-    HWND fg = GetForegroundWindow();
-    for (int i = 0; i < static_cast<int>(g_windows.size()); ++i) {
-        if (g_windows[i].hwnd == fg) {
-            if (g_cursor != i) {
-                g_cursor = i;
-                if (g_state == AnimState::VISIBLE)
-                    render_frame(1.0f);
-                // During INTRO, next animation frame picks up new cursor
-            }
-            return;
-        }
+    set_cursor(find_window(fg));
+}
+
+// Copy the model into g_allWindows in MRU order and re-filter, keeping the
+// cursor on the same window. False if the snapshot was already current.
+bool take_snapshot() {
+    perf::ScopedTimer timer(g_snapshotTime);
+    if (g_windowsVersion == window_model::version() && !g_allWindows.empty())
+        return false;
+
+    g_allWindows = window_model::entries();
+    g_windowsVersion = window_model::version();
+    order_by_recency();
+    if (!g_matcher.pattern().empty()) ensure_candidates();
+    select_matches();
+    return true;
+}
+
+// Lay out, rasterize and (once the intro is over) repaint g_windows
+void relayout() {
+    compute_layout();
+    reserve(g_panelDib, g_panelW, g_panelH);
+    build_atlas();
+    if (g_state == AnimState::VISIBLE)
+        render_frame(intro_ms());
+}
+
+// Re-layout after the window list changed under a visible panel
+void refresh_from_model() {
+    take_snapshot();
+    if (g_windows.empty()) {
+        hide();
+        return;
     }
-    if (g_cursor != -1) {
-        g_cursor = -1;
-        if (g_state == AnimState::VISIBLE)
-            render_frame(1.0f);
+    relayout();
+}
+
+// Narrow (or widen) the chips by one key; the best match is highlighted
+// and focused like a move. A letter that would leave no match is ignored.
+void on_filter_key(int id) {
+    if (!g_hwnd || g_state == AnimState::IDLE
+        || g_state == AnimState::FADEOUT) return;
+    perf::ScopedTimer timer(g_filterTime);
+
+    ensure_candidates();
+    bool changed = (id == kFilterBackId)
+        ? g_matcher.pop()
+        : g_matcher.push(static_cast<wchar_t>(L'a' + (id - kFilterLetterId)));
+    if (!changed) return;
+
+    if (!g_matcher.pattern().empty()) g_cursor = -1;
+    select_matches();
+    relayout();
+    if (g_cursor >= 0) request_focus();
+}
+
+void CALLBACK win_event_proc(HWINEVENTHOOK, DWORD event, HWND hwnd,
+                             LONG idObject, LONG idChild, DWORD, DWORD) {
+    (g_openHooks[0] ? g_eventWakeups : g_idleEventWakeups).add();
+    if (!hwnd || idObject != OBJID_WINDOW || idChild != CHILDID_SELF) return;
+
+    // Removals are applied whether or not the panel is shown; the rest only
+    // arrive while it is
+    bool changed = false;
+    switch (event) {
+    case EVENT_SYSTEM_FOREGROUND:
+        g_recent.touch(hwnd);
+        break;
+    case EVENT_OBJECT_DESTROY:
+        g_recent.erase(hwnd);
+        changed = window_model::on_destroyed(hwnd);
+        break;
+    case EVENT_OBJECT_HIDE:
+    case EVENT_SYSTEM_MINIMIZESTART:
+        changed = window_model::on_removed(hwnd);
+        break;
+    case EVENT_OBJECT_NAMECHANGE:
+        if (GetAncestor(hwnd, GA_ROOT) == hwnd)
+            changed = window_model::on_renamed(hwnd);
+        break;
+    default:  // CREATE, SHOW, MINIMIZEEND
+        if (GetAncestor(hwnd, GA_ROOT) == hwnd)
+            changed = window_model::on_shown(hwnd);
+        break;
     }
+
+    if (!g_hwnd || g_state == AnimState::IDLE
+        || g_state == AnimState::FADEOUT) return;
+    if (changed) refresh_from_model();
+    if (event == EVENT_SYSTEM_FOREGROUND) sync_cursor_to_foreground(hwnd);
 }
 
-LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
-    if (msg == WM_TIMER) {
-        if (wParam == kFocusTimerId) {
-            sync_cursor_to_foreground();
-            return 0;
-        }
-        if (wParam == kAnimTimerId) {
-            ULONGLONG now = GetTickCount64();
-            float elapsed = static_cast<float>(now - g_animStart);
-
-            if (g_state == AnimState::INTRO) {
-                int n = static_cast<int>(g_chips.size());
-                DWORD totalMs = kChipAnimMs
-                    + (n > 1 ? (n - 1) * kChipStaggerMs : 0);
-                float t = elapsed / totalMs;
-                if (t >= 1.0f) {
-                    g_state = AnimState::VISIBLE;
-                    KillTimer(g_hwnd, kAnimTimerId);
-                    render_frame(1.0f);
-                } else {
-                    render_frame(t);
-                }
-            } else if (g_state == AnimState::FADEOUT) {
-                float t = elapsed / kFadeOutMs;
-                if (t >= 1.0f) {
-                    do_hide();
-                } else {
-                    // Ease-in quadratic (accelerating fade)
-                    float alpha = 1.0f - t * t;
-                    BYTE a = static_cast<BYTE>(alpha * kPanelAlpha);
-                    POINT ptSrc = {0, 0};
-                    SIZE sizeWnd = {g_panelW, g_panelH};
-                    BLENDFUNCTION blend = {};
-                    blend.BlendOp = AC_SRC_OVER;
-                    blend.SourceConstantAlpha = a;
-                    blend.AlphaFormat = AC_SRC_ALPHA;
-                    UpdateLayeredWindow(g_hwnd, nullptr, nullptr, &sizeWnd,
-                                        g_hdcMem, &ptSrc, 0, &blend,
-                                        ULW_ALPHA);
-                }
-            }
-            return 0;
+using EventRange = DWORD[2];
+
+template <size_t N>
+void unhook(HWINEVENTHOOK (&hooks)[N]) {
+    for (auto& h : hooks) {
+        if (h) { UnhookWinEvent(h); h = nullptr; }
+    }
+}
+
+// Out-of-context hooks are delivered through this thread's message loop
+template <size_t N>
+bool hook(HWINEVENTHOOK (&hooks)[N], const EventRange (&ranges)[N]) {
+    for (size_t i = 0; i < N; ++i) {
+        hooks[i] = SetWinEventHook(
+            ranges[i][0], ranges[i][1], nullptr, win_event_proc, 0, 0,
+            WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+        if (!hooks[i]) {
+            unhook(hooks);
+            return false;
         }
     }
-    return DefWindowProcW(hwnd, msg, wParam, lParam);
+    return true;
 }
 
-}  // namespace
+void remove_hooks() {
+    remove_open_hooks();
+    unhook(g_idleHooks);
+    g_idleEventWakeups.end();
+}
 
-bool init(HINSTANCE hInstance) {
-    g_hInstance = hInstance;
+bool install_hooks() {
+    constexpr EventRange kIdleRanges[] = {
+        {EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND},
+        {EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND},
+        {EVENT_OBJECT_DESTROY, EVENT_OBJECT_DESTROY},
+    };
+    if (!hook(g_idleHooks, kIdleRanges)) return false;
+    g_idleEventWakeups.begin();
+    return true;
+}
 
-    WNDCLASSEXW wc = {};
-    wc.cbSize = sizeof(wc);
-    wc.lpfnWndProc = wndproc;
-    wc.hInstance = hInstance;
-    wc.lpszClassName = kClassName;
+bool install_open_hooks() {
+    if (g_openHooks[0]) return true;
+    constexpr EventRange kOpenRanges[] = {
+        {EVENT_OBJECT_CREATE, EVENT_OBJECT_CREATE},
+        {EVENT_OBJECT_SHOW, EVENT_OBJECT_HIDE},
+        {EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE},
+    };
+    if (!hook(g_openHooks, kOpenRanges)) return false;
+    g_idleEventWakeups.end();
+    g_eventWakeups.begin();
+    return true;
+}
 
-    return RegisterClassExW(&wc) != 0;
+void remove_open_hooks() {
+    if (!g_openHooks[0]) return;
+    unhook(g_openHooks);
+    g_eventWakeups.end();
+    if (g_idleHooks[0]) g_idleEventWakeups.begin();
 }
 
-void toggle() {
-    // Cancel fade-out if in progress
-    if (g_state == AnimState::FADEOUT) {
-        KillTimer(g_hwnd, kAnimTimerId);
-        g_state = AnimState::IDLE;
+// Intro / fade-out frame
+void tick_anim() {
+    uint64_t elapsed_ms = GetTickCount64() - g_animStart;
+
+    if (g_state == AnimState::INTRO) {
+        if (elapsed_ms >= intro_ms()) {
+            g_state = AnimState::VISIBLE;
+            frame_scheduler::stop(g_anim);
+            render_frame(intro_ms());
+        } else {
+            render_frame(elapsed_ms);
+        }
+    } else if (g_state == AnimState::FADEOUT) {
+        float t = static_cast<float>(elapsed_ms) / kFadeOutMs;
+        if (t >= 1.0f) {
+            do_hide();
+        } else {
+            // Ease-in quadratic (accelerating fade)
+            float alpha = 1.0f - t * t;
+            present_alpha(static_cast<BYTE>(alpha * kPanelAlpha));
+        }
     }
+}
 
-    enumerate_windows();
-    if (g_windows.empty()) {
-        hide();
+// Refresh the model off the UI thread; synchronously if that is not possible
+void start_rebuild() {
+    if (!window_model::rebuild_async(g_msgHwnd, kModelMessage))
+        window_model::rebuild();
+}
+
+void show_panel();
+
+void on_model_batch() {
+    bool changed = window_model::merge_async();
+    if (g_openWhenReady) {
+        if (!changed && window_model::rebuild_pending()) return;
+        g_openWhenReady = false;
+        show_panel();
         return;
     }
+    if (changed && g_hwnd && g_state != AnimState::IDLE
+        && g_state != AnimState::FADEOUT) {
+        refresh_from_model();
+    }
+}
 
-    if (!g_hwnd) {
-        constexpr DWORD exStyle = WS_EX_TOPMOST | WS_EX_TOOLWINDOW
-                                | WS_EX_NOACTIVATE | WS_EX_LAYERED;
-        g_hwnd = CreateWindowExW(
-            exStyle, kClassName, L"",
-            WS_POPUP,
-            0, 0, 0, 0,
-            nullptr, nullptr, g_hInstance, nullptr);
-        if (!g_hwnd) return;
+LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    if (msg == WM_TIMER && wParam == kFocusTimerId) {
+        g_pollWakeups.add();
+        HWND fg = GetForegroundWindow();
+        if (fg) g_recent.touch(fg);
+        sync_cursor_to_foreground(fg);
+        return 0;
+    }
+    if (msg == kModelMessage) {
+        on_model_batch();
+        return 0;
     }
+    if (msg == WM_HOTKEY) {
+        on_filter_key(static_cast<int>(wParam));
+        return 0;
+    }
+    return DefWindowProcW(hwnd, msg, wParam, lParam);
+}
 
-    compute_layout();
-    create_bitmap(g_panelW, g_panelH);
-    if (!g_pixels) return;
+// Cancel a fade-out so the panel can be moved again
+void resume_from_fadeout() {
+    if (g_state != AnimState::FADEOUT) return;
+    frame_scheduler::stop(g_anim);
+    g_state = AnimState::VISIBLE;
+    start_tracking();
+}
 
-    // Set cursor to current foreground window
-    HWND fg = GetForegroundWindow();
+void move_to(int i) {
+    resume_from_fadeout();
+    set_cursor(i);
+    request_focus();
+}
+
+// Jumps may open the panel; false if there is nothing to jump to
+bool ensure_shown() {
+    if (!g_hwnd || g_state == AnimState::IDLE) toggle();
+    return g_hwnd && !g_windows.empty();
+}
+
+// Snapshot the model and open (or re-open) the panel on it
+void show_panel() {
     g_cursor = -1;
-    for (int i = 0; i < static_cast<int>(g_windows.size()); ++i) {
-        if (g_windows[i].hwnd == fg) { g_cursor = i; break; }
+    g_matcher.clear();  // a toggle starts over on the full list
+    HWND fg = GetForegroundWindow();
+    if (fg) g_recent.touch(fg);  // poll mode sees no focus changes while hidden
+    g_openRecent = g_recent;
+    if (!take_snapshot()) {
+        order_by_recency();
+        select_matches();
+    }
+    if (g_windows.empty()) {
+        // First toggle before the first pass finished
+        g_openWhenReady = window_model::rebuild_pending();
+        hide();
+        return;
     }
 
+    bool cold = !g_hwnd;
+    if (cold && !create_panel_window()) return;
+
+    // Cursor on the window focused before the current one (next after it
+    // in MRU order), so one toggle flips between the last two
+    int n = static_cast<int>(g_windows.size());
+    g_cursor = (find_window(fg) + 1) % n;
+
+    compute_layout();
+    reserve(g_panelDib, g_panelW, g_panelH);
+    build_atlas();
+    if (!g_panelDib.pixels || !g_atlasDib.pixels) return;
+
     // Start intro animation
     g_state = AnimState::INTRO;
     g_animStart = GetTickCount64();
-    render_frame(0.0f);
+    render_frame(0);
 
     ShowWindow(g_hwnd, SW_SHOWNOACTIVATE);
-    SetTimer(g_hwnd, kAnimTimerId, kAnimFrameMs, nullptr);
-    SetTimer(g_hwnd, kFocusTimerId, kFocusPollMs, nullptr);
+    if (g_toggleStartNs) {
+        (cold ? g_firstPixelCold : g_firstPixelWarm)
+            .record(perf::now_ns() - g_toggleStartNs);
+        g_toggleStartNs = 0;
+    }
+    frame_scheduler::start(g_anim);
+    start_tracking();
+    register_filter_keys();
+    if (g_windows[g_cursor].hwnd != fg) request_focus();
 }
 
-void move_left() {
-    if (!g_hwnd || g_windows.empty()) return;
+}  // namespace
 
-    // Cancel fade-out
+bool init(HINSTANCE hInstance, TrackingMode mode, int max_rows,
+          bool prewarm) {
+    g_hInstance = hInstance;
+    g_maxRows = std::max(max_rows, 1);
+    g_prewarm = prewarm;
+
+    WNDCLASSEXW wc = {};
+    wc.cbSize = sizeof(wc);
+    wc.lpfnWndProc = wndproc;
+    wc.hInstance = hInstance;
+    wc.lpszClassName = kClassName;
+
+    if (!RegisterClassExW(&wc)) return false;
+    if (!create_text_resources()) return false;
+
+    g_msgHwnd = CreateWindowExW(0, kClassName, L"", 0, 0, 0, 0, 0,
+                                HWND_MESSAGE, nullptr, hInstance, nullptr);
+    if (!g_msgHwnd) return false;
+
+    // Prewarm: the window and surfaces for a full-width panel exist before
+    // the first toggle. Not fatal; the first open then creates them.
+    if (g_prewarm && create_panel_window()) {
+        int item_h = g_textHeight + kItemPaddingY * 2;
+        int panel_h = g_maxRows * item_h + (g_maxRows - 1) * kItemSpacing
+                    + kPanelPaddingY * 2;
+        reserve(g_panelDib, kMaxPanelWidth, panel_h);
+        reserve(g_atlasDib, kMaxPanelWidth, panel_h * 2);
+    }
+
+    // Fall back to polling if the hooks cannot be installed
+    g_tracking = (mode == TrackingMode::Event && install_hooks())
+        ? TrackingMode::Event : TrackingMode::Poll;
+    // Warm the model so the first toggle has a list to show
+    start_rebuild();
+    return true;
+}
+
+void toggle() {
+    g_toggleStartNs = perf::now_ns();
+    g_dibAllocs.add_base();
+    apply_pending_focus();
+
+    // Cancel fade-out if in progress
     if (g_state == AnimState::FADEOUT) {
-        KillTimer(g_hwnd, kAnimTimerId);
-        g_state = AnimState::VISIBLE;
-        SetTimer(g_hwnd, kFocusTimerId, kFocusPollMs, nullptr);
+        frame_scheduler::stop(g_anim);
+        g_state = AnimState::IDLE;
     }
 
-    int n = static_cast<int>(g_windows.size());
-    if (g_cursor <= 0)
-        g_cursor = n - 1;
-    else
-        g_cursor--;
+    // Hidden, the model misses new, shown and renamed windows (and in poll
+    // mode everything); the panel opens on the previous list and picks up
+    // the fresh one as it arrives
+    start_rebuild();
+    show_panel();
+}
 
-    if (g_state == AnimState::VISIBLE)
-        render_frame(1.0f);
-    focus_current();
+void move_left() {
+    if (!g_hwnd || g_windows.empty()) return;
+    int n = static_cast<int>(g_windows.size());
+    move_to(g_cursor <= 0 ? n - 1 : g_cursor - 1);
 }
 
 void move_right() {
     if (!g_hwnd || g_windows.empty()) return;
+    move_to((g_cursor + 1) % static_cast<int>(g_windows.size()));
+}
 
-    // Cancel fade-out
-    if (g_state == AnimState::FADEOUT) {
-        KillTimer(g_hwnd, kAnimTimerId);
-        g_state = AnimState::VISIBLE;
-        SetTimer(g_hwnd, kFocusTimerId, kFocusPollMs, nullptr);
-    }
+void jump_to(int slot) {
+    if (slot < 0 || !ensure_shown()) return;
+    if (slot >= static_cast<int>(g_windows.size())) return;
+    move_to(slot);
+}
 
-    g_cursor = (g_cursor + 1) % static_cast<int>(g_windows.size());
+void jump_to_initial(wchar_t c) {
+    int b = initial_of(c);
+    if (b < 0 || !ensure_shown()) return;
 
-    if (g_state == AnimState::VISIBLE)
-        render_frame(1.0f);
-    focus_current();
+    // Repeating the same initial cycles through its chips
+    int i = g_firstByInitial[b];
+    if (g_cursor >= 0 && g_cursor < static_cast<int>(g_windows.size())
+        && initial_at(g_cursor) == b && g_nextByInitial[g_cursor] >= 0) {
+        i = g_nextByInitial[g_cursor];
+    }
+    if (i >= 0) move_to(i);
 }
 
 void hide() {
-    if (!g_hwnd || g_state == AnimState::FADEOUT) return;
+    if (!g_hwnd || g_state == AnimState::IDLE
+        || g_state == AnimState::FADEOUT) return;
 
-    KillTimer(g_hwnd, kFocusTimerId);
+    // The last move still lands
+    apply_pending_focus();
+    stop_tracking();
+    unregister_filter_keys();
     if (g_state == AnimState::INTRO)
-        KillTimer(g_hwnd, kAnimTimerId);
+        frame_scheduler::stop(g_anim);
 
     // Render final frame for clean fade-out source
-    render_frame(1.0f);
+    render_frame(intro_ms());
 
     g_state = AnimState::FADEOUT;
     g_animStart = GetTickCount64();
-    SetTimer(g_hwnd, kAnimTimerId, kAnimFrameMs, nullptr);
+    frame_scheduler::start(g_anim);
 }
 
 void shutdown() {
+    remove_hooks();
     g_state = AnimState::IDLE;
     do_hide();
+    if (g_hwnd) { DestroyWindow(g_hwnd); g_hwnd = nullptr; }
+    window_model::clear();
+    if (g_msgHwnd) { DestroyWindow(g_msgHwnd); g_msgHwnd = nullptr; }
+    release(g_panelDib);
+    release(g_atlasDib);
+    free_text_resources();
+    // Leak check: every DC / bitmap the pool created has been deleted
+    if (g_gdiObjects.value() != 0)
+        OutputDebugStringA("[switcher] leaked GDI objects, see "
+                           "switcher.gdi_objects\n");
     UnregisterClassW(kClassName, g_hInstance);
 }
 
@@ -3,10 +3,30 @@
 
 namespace switcher {
 
-bool init(HINSTANCE hInstance);
-void toggle();       // Enumerate + show/refresh list
+// How the open panel follows focus and window list changes
+enum class TrackingMode {
+    Event,  // WinEvent hooks (falls back to Poll if they cannot be installed)
+    Poll,   // GetForegroundWindow() every 100 ms while the panel is shown
+};
+
+// The panel is at most 960 px wide; chips that do not fit wrap into lines,
+// of which max_rows are shown at a time, scrolling with the cursor.
+// prewarm creates the panel window and its surfaces up front and only
+// hides them between uses, so a toggle just redraws and shows.
+bool init(HINSTANCE hInstance, TrackingMode mode = TrackingMode::Event,
+          int max_rows = 1, bool prewarm = true);
+// Snapshot window list + show/refresh. Chips are in most-recently-focused
+// order and the window focused before the current one is pre-selected, so
+// a single toggle flips back to it. From opening until the hotkey's
+// modifiers are released, Alt+letters filter the chips by a fuzzy match on
+// name and title (Alt+Backspace undoes one letter); the best match is
+// highlighted and focused.
+void toggle();
 void move_left();    // Move cursor left + focus
 void move_right();   // Move cursor right + focus
+// Direct jumps; open the panel first if needed. O(1) per call.
+void jump_to(int slot);            // slot'th chip from the left (0-based)
+void jump_to_initial(wchar_t c);   // next chip whose title starts with c
 void hide();
 void shutdown();
 
@@ -0,0 +1,460 @@
+#include "window_model.h"
+#include "perf.h"
+#include "ci_lookup.h"
+#include "display_name.h"
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace window_model {
+namespace {
+
+std::vector<Entry> g_entries;
+std::unordered_map<HWND, size_t> g_index;  // hwnd -> position in g_entries
+bool g_titles_dirty = false;
+uint64_t g_version = 0;
+
+perf::Histogram g_rebuildTime{"window_model.rebuild"};
+perf::Histogram g_asyncRebuildTime{"window_model.rebuild_async"};
+perf::Counter g_textTimeouts{"window_model.text_timeouts"};
+
+// Title queries are messages to the window's thread; a hung window costs
+// at most this long and is then left out
+constexpr UINT kWindowTimeoutMs = 50;
+
+// Async pass: the worker publishes what it has at least this often
+constexpr uint64_t kBatchIntervalNs = 16'000'000;
+
+HANDLE g_worker = nullptr;
+std::atomic<bool> g_workerCancel{false};
+HWND g_notifyHwnd = nullptr;
+UINT g_notifyMsg = 0;
+
+// Worker -> UI thread hand-off
+std::mutex g_stagingMutex;
+std::vector<Entry> g_staging;
+bool g_stagingDone = false;
+
+// UI thread bookkeeping for the pass being merged. Diffs that arrive
+// meanwhile are newer than the worker's view and win over it.
+bool g_passActive = false;
+std::unordered_set<HWND> g_passSeen;     // listed by the pass or a diff
+std::unordered_set<HWND> g_passRemoved;  // removed by a diff meanwhile
+
+// Window class names to exclude (our own windows)
+constexpr std::wstring_view kExcludeClassNames[] = {
+    L"CustomKeypadIndicator",
+    L"CustomKeypadOverlay",
+    L"CustomKeypadSwitcher",
+    L"CustomKeypadMsg",
+    L"CustomKeypadEdgeFlash",
+};
+constexpr auto kExcludeClasses = ci_lookup::make_set(kExcludeClassNames);
+
+// Process names to exclude from the window list
+constexpr std::wstring_view kExcludeProcessNames[] = {
+    L"TextInputHost",
+    L"ApplicationFrameHost",
+    L"SystemSettings",
+};
+constexpr auto kExcludeProcesses = ci_lookup::make_set(kExcludeProcessNames);
+
+// Deployment-specific additions (see set_user_exclusions)
+constexpr size_t kMaxUserExclusions = 1024;
+ci_lookup::Set<kMaxUserExclusions> g_userExcludeClasses;
+ci_lookup::Set<kMaxUserExclusions> g_userExcludeProcesses;
+
+// PID -> display name. Each entry holds a handle to its process, which keeps
+// the PID from being reused while cached; the entry is dropped once that
+// handle is signaled (process exited).
+struct CachedName {
+    HANDLE process;
+    std::wstring name;
+};
+
+// Shared by the UI thread and the async worker
+std::mutex g_nameMutex;
+std::unordered_map<DWORD, CachedName> g_nameCache;
+
+perf::Counter g_nameHits{"window_model.name_cache.hits"};
+perf::Counter g_nameMisses{"window_model.name_cache.misses"};
+perf::Counter g_nameEvictions{"window_model.name_cache.evictions"};
+
+bool has_exited(HANDLE process) {
+    return WaitForSingleObject(process, 0) != WAIT_TIMEOUT;
+}
+
+void evict_exited() {
+    std::lock_guard lock(g_nameMutex);
+    for (auto it = g_nameCache.begin(); it != g_nameCache.end();) {
+        if (has_exited(it->second.process)) {
+            CloseHandle(it->second.process);
+            it = g_nameCache.erase(it);
+            g_nameEvictions.add();
+        } else {
+            ++it;
+        }
+    }
+}
+
+void clear_name_cache() {
+    std::lock_guard lock(g_nameMutex);
+    for (auto& [pid, cached] : g_nameCache) CloseHandle(cached.process);
+    g_nameCache.clear();
+}
+
+std::wstring get_display_name(HWND hwnd) {
+    DWORD pid = 0;
+    GetWindowThreadProcessId(hwnd, &pid);
+    if (pid == 0) return L"";
+
+    {
+        std::lock_guard lock(g_nameMutex);
+        auto it = g_nameCache.find(pid);
+        if (it != g_nameCache.end()) {
+            if (!has_exited(it->second.process)) {
+                g_nameHits.add();
+                return it->second.name;
+            }
+            CloseHandle(it->second.process);
+            g_nameCache.erase(it);
+            g_nameEvictions.add();
+        }
+    }
+    g_nameMisses.add();
+
+    // Resolved without the lock; the other thread may race us to the entry
+    HANDLE hProcess = OpenProcess(
+        PROCESS_QUERY_LIMITED_INFORMATION | SYNCHRONIZE, FALSE, pid);
+    if (!hProcess) return L"";
+
+    wchar_t path[MAX_PATH] = {};
+    DWORD pathLen = MAX_PATH;
+    if (!QueryFullProcessImageNameW(hProcess, 0, path, &pathLen)) {
+        CloseHandle(hProcess);
+        return L"";
+    }
+
+    std::wstring name = display_name::from_path(std::wstring_view(path, pathLen));
+    std::lock_guard lock(g_nameMutex);
+    if (!g_nameCache.emplace(pid, CachedName{hProcess, name}).second)
+        CloseHandle(hProcess);
+    return name;
+}
+
+// WM_GETTEXTLENGTH / WM_GETTEXT with kWindowTimeoutMs; false on timeout
+bool window_text_length(HWND hwnd, int& len) {
+    DWORD_PTR result = 0;
+    if (!SendMessageTimeoutW(hwnd, WM_GETTEXTLENGTH, 0, 0, SMTO_ABORTIFHUNG,
+                             kWindowTimeoutMs, &result)) {
+        g_textTimeouts.add();
+        return false;
+    }
+    len = static_cast<int>(result);
+    return true;
+}
+
+bool window_text(HWND hwnd, int len, std::wstring& text) {
+    text.assign(len + 1, L'\0');
+    DWORD_PTR copied = 0;
+    if (!SendMessageTimeoutW(hwnd, WM_GETTEXT, len + 1,
+                             reinterpret_cast<LPARAM>(text.data()),
+                             SMTO_ABORTIFHUNG, kWindowTimeoutMs, &copied)) {
+        g_textTimeouts.add();
+        return false;
+    }
+    text.resize(std::min<size_t>(copied, len));
+    return true;
+}
+
+// Build an entry for hwnd; false if it should not appear in the switcher
+bool make_entry(HWND hwnd, Entry& entry) {
+    if (!IsWindowVisible(hwnd)) return false;
+    if (IsIconic(hwnd)) return false;
+
+    LONG_PTR exStyle = GetWindowLongPtrW(hwnd, GWL_EXSTYLE);
+    if (exStyle & WS_EX_TOOLWINDOW) return false;
+
+    HWND owner = GetWindow(hwnd, GW_OWNER);
+    if (owner != nullptr && !(exStyle & WS_EX_APPWINDOW)) return false;
+
+    wchar_t cls[128] = {};
+    int clsLen = GetClassNameW(hwnd, cls, 128);
+    std::wstring_view clsName(cls, clsLen > 0 ? clsLen : 0);
+    if (kExcludeClasses.contains(clsName)
+        || g_userExcludeClasses.contains(clsName)) return false;
+
+    // Checks above read window state directly; from here on the window's
+    // thread (or another process) is involved
+    int len = 0;
+    if (!window_text_length(hwnd, len) || len == 0) return false;
+
+    std::wstring display = get_display_name(hwnd);
+
+    if (kExcludeProcesses.contains(display)
+        || g_userExcludeProcesses.contains(display)) return false;
+    entry.name_from_title = display.empty();
+    if (display.empty() && !window_text(hwnd, len, display)) return false;
+
+    entry.hwnd = hwnd;
+    entry.name = std::move(display);
+    return true;
+}
+
+BOOL CALLBACK enum_callback(HWND hwnd, LPARAM) {
+    Entry entry;
+    if (make_entry(hwnd, entry)) {
+        g_index[hwnd] = g_entries.size();
+        g_entries.push_back(std::move(entry));
+    }
+    return TRUE;
+}
+
+// Append " (n)" to names shared by more than one window
+void disambiguate_titles() {
+    std::unordered_map<std::wstring, int> counts;
+    for (const auto& e : g_entries) counts[e.name]++;
+
+    std::unordered_map<std::wstring, int> seen;
+    for (auto& e : g_entries) {
+        e.title = e.name;
+        if (counts[e.name] > 1) {
+            int idx = ++seen[e.name];
+            e.title += L" (" + std::to_wstring(idx) + L")";
+        }
+    }
+}
+
+void mark_changed() {
+    g_titles_dirty = true;
+    ++g_version;
+}
+
+void reindex_from(size_t pos) {
+    for (size_t i = pos; i < g_entries.size(); ++i) {
+        g_index[g_entries[i].hwnd] = i;
+    }
+}
+
+// Insert or update; true if the list changed
+bool upsert(Entry&& entry) {
+    auto it = g_index.find(entry.hwnd);
+    if (it != g_index.end()) {
+        Entry& cur = g_entries[it->second];
+        if (cur.name == entry.name) return false;
+        cur.name = std::move(entry.name);
+        cur.name_from_title = entry.name_from_title;
+    } else {
+        g_index.emplace(entry.hwnd, g_entries.size());
+        g_entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+// ---- Async rebuild ---------------------------------------------------------
+
+void publish(std::vector<Entry>& batch, bool done) {
+    {
+        std::lock_guard lock(g_stagingMutex);
+        for (auto& e : batch) g_staging.push_back(std::move(e));
+        g_stagingDone = done;
+    }
+    batch.clear();
+    PostMessageW(g_notifyHwnd, g_notifyMsg, 0, 0);
+}
+
+BOOL CALLBACK collect_callback(HWND hwnd, LPARAM lp) {
+    reinterpret_cast<std::vector<HWND>*>(lp)->push_back(hwnd);
+    return TRUE;
+}
+
+DWORD WINAPI worker_main(LPVOID) {
+    uint64_t start = perf::now_ns();
+    std::vector<HWND> hwnds;
+    EnumWindows(collect_callback, reinterpret_cast<LPARAM>(&hwnds));
+
+    std::vector<Entry> batch;
+    uint64_t last_publish = start;
+    for (HWND hwnd : hwnds) {
+        if (g_workerCancel.load(std::memory_order_relaxed)) break;
+        Entry entry;
+        if (make_entry(hwnd, entry)) batch.push_back(std::move(entry));
+        uint64_t now = perf::now_ns();
+        if (!batch.empty() && now - last_publish >= kBatchIntervalNs) {
+            publish(batch, false);
+            last_publish = now;
+        }
+    }
+    publish(batch, true);
+    g_asyncRebuildTime.record(perf::now_ns() - start);
+    return 0;
+}
+
+// Waits for the worker (if any) and discards whatever it left unmerged
+void stop_worker() {
+    if (g_worker) {
+        g_workerCancel.store(true, std::memory_order_relaxed);
+        WaitForSingleObject(g_worker, INFINITE);
+        CloseHandle(g_worker);
+        g_worker = nullptr;
+    }
+    std::lock_guard lock(g_stagingMutex);
+    g_staging.clear();
+    g_stagingDone = false;
+    g_passActive = false;
+    g_passSeen.clear();
+    g_passRemoved.clear();
+}
+
+}  // namespace
+
+void rebuild() {
+    perf::ScopedTimer timer(g_rebuildTime);
+    stop_worker();
+    evict_exited();
+    g_entries.clear();
+    g_index.clear();
+    EnumWindows(enum_callback, 0);
+    disambiguate_titles();
+    g_titles_dirty = false;
+    ++g_version;
+}
+
+bool rebuild_async(HWND notify_hwnd, UINT notify_msg) {
+    if (g_passActive) return true;
+    stop_worker();
+    evict_exited();
+
+    g_notifyHwnd = notify_hwnd;
+    g_notifyMsg = notify_msg;
+    g_workerCancel.store(false, std::memory_order_relaxed);
+    g_worker = CreateThread(nullptr, 0, worker_main, nullptr, 0, nullptr);
+    g_passActive = g_worker != nullptr;
+    return g_passActive;
+}
+
+bool merge_async() {
+    if (!g_passActive) return false;
+    std::vector<Entry> batch;
+    bool done;
+    {
+        std::lock_guard lock(g_stagingMutex);
+        batch.swap(g_staging);
+        done = g_stagingDone;
+    }
+
+    bool changed = false;
+    for (auto& e : batch) {
+        if (g_passRemoved.contains(e.hwnd)) continue;
+        g_passSeen.insert(e.hwnd);
+        changed |= upsert(std::move(e));
+    }
+
+    if (done) {
+        // Windows the pass did not find are gone
+        size_t kept = 0;
+        for (size_t i = 0; i < g_entries.size(); ++i) {
+            if (!g_passSeen.contains(g_entries[i].hwnd)) {
+                g_index.erase(g_entries[i].hwnd);
+                continue;
+            }
+            if (kept != i) g_entries[kept] = std::move(g_entries[i]);
+            ++kept;
+        }
+        if (kept != g_entries.size()) {
+            g_entries.resize(kept);
+            reindex_from(0);
+            changed = true;
+        }
+        stop_worker();
+    }
+
+    if (changed) mark_changed();
+    return changed;
+}
+
+bool rebuild_pending() {
+    return g_passActive;
+}
+
+bool set_user_exclusions(std::span<const std::wstring_view> processes,
+                         std::span<const std::wstring_view> classes) {
+    stop_worker();  // the worker reads the exclusion sets
+    bool ok = g_userExcludeProcesses.build(processes.data(), processes.size())
+           && g_userExcludeClasses.build(classes.data(), classes.size());
+    if (!ok) {
+        g_userExcludeProcesses.clear();
+        g_userExcludeClasses.clear();
+    }
+    if (!g_entries.empty()) rebuild();
+    return ok;
+}
+
+void clear() {
+    stop_worker();
+    clear_name_cache();
+    g_entries.clear();
+    g_index.clear();
+    mark_changed();
+}
+
+bool on_shown(HWND hwnd) {
+    Entry entry;
+    if (!make_entry(hwnd, entry)) return on_removed(hwnd);
+
+    if (g_passActive) {
+        g_passSeen.insert(hwnd);
+        g_passRemoved.erase(hwnd);
+    }
+    if (!upsert(std::move(entry))) return false;
+    mark_changed();
+    return true;
+}
+
+bool on_removed(HWND hwnd) {
+    if (g_passActive) {
+        g_passSeen.erase(hwnd);
+        g_passRemoved.insert(hwnd);
+    }
+    auto it = g_index.find(hwnd);
+    if (it == g_index.end()) return false;
+
+    size_t pos = it->second;
+    g_index.erase(it);
+    g_entries.erase(g_entries.begin() + static_cast<ptrdiff_t>(pos));
+    reindex_from(pos);
+    mark_changed();
+    return true;
+}
+
+bool on_destroyed(HWND hwnd) {
+    if (!on_removed(hwnd)) return false;
+    // Lookups evict lazily too; this only bounds the handles held
+    evict_exited();
+    return true;
+}
+
+bool on_renamed(HWND hwnd) {
+    // A process-named entry is unaffected by its title; only windows not yet
+    // listed (empty title before) or title-named ones need a fresh look
+    auto it = g_index.find(hwnd);
+    if (it != g_index.end() && !g_entries[it->second].name_from_title)
+        return false;
+    return on_shown(hwnd);
+}
+
+const std::vector<Entry>& entries() {
+    if (g_titles_dirty) {
+        disambiguate_titles();
+        g_titles_dirty = false;
+    }
+    return g_entries;
+}
+
+uint64_t version() {
+    return g_version;
+}
+
+}  // namespace window_model
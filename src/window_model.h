@@ -0,0 +1,53 @@
+#pragma once
+#include <windows.h>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Long-lived list of switchable top-level windows.
+// Built once with EnumWindows and then kept current by per-window diffs, so
+// the switcher can take a cheap snapshot instead of re-enumerating.
+// Everything here runs on the UI thread except the rebuild_async() worker,
+// which only produces entries for merge_async() to apply.
+namespace window_model {
+
+struct Entry {
+    HWND hwnd;
+    std::wstring name;   // display name before disambiguation
+    std::wstring title;  // name + " (n)" suffix when duplicated
+    bool name_from_title = false;  // no process name; name tracks the title
+};
+
+void rebuild();       // Full EnumWindows pass (initial build / poll fallback)
+void clear();
+
+// Full pass on a worker thread. The current entries stay usable; results
+// arrive in batches, each announced by posting notify_msg to notify_hwnd.
+// A pass already running is reused. False if no worker could be started.
+bool rebuild_async(HWND notify_hwnd, UINT notify_msg);
+// notify_msg handler: applies the batches received so far (the last one
+// also drops windows the pass did not find). True if the list changed.
+bool merge_async();
+bool rebuild_pending();  // an async pass has not been fully merged yet
+
+// Extra process / window-class names to hide, matched case-insensitively
+// (up to 1024 each). The strings must outlive the model. Returns false and
+// clears both lists if they cannot be indexed.
+bool set_user_exclusions(std::span<const std::wstring_view> processes,
+                         std::span<const std::wstring_view> classes);
+
+// Diffs; each returns true if the list changed
+bool on_shown(HWND hwnd);    // created, shown or restored
+bool on_removed(HWND hwnd);  // hidden or minimized
+// Destroyed; also drops cached names of processes that have exited
+bool on_destroyed(HWND hwnd);
+bool on_renamed(HWND hwnd);
+
+// Entries in stable order (enumeration order, new windows appended)
+const std::vector<Entry>& entries();
+// Bumped on every change; lets callers skip redundant snapshots
+uint64_t version();
+
+}  // namespace window_model
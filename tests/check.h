@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Minimal assertions for the native tests: a failed CHECK is reported and
+// counted, and main() returns check::result().
+namespace check {
+
+inline int g_failures = 0;
+
+inline void fail(const char* file, int line, const char* what) {
+    std::printf("%s:%d: FAILED: %s\n", file, line, what);
+    ++g_failures;
+}
+
+inline int result() {
+    if (g_failures) std::printf("%d check(s) failed\n", g_failures);
+    else std::printf("all checks passed\n");
+    return g_failures ? 1 : 0;
+}
+
+// FNV-1a over a width x height BGRA image (stride in pixels), for golden
+// images kept as digests
+inline uint64_t digest(const uint32_t* px, int width, int height,
+                       int stride) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint32_t p = px[y * stride + x];
+            for (int b = 0; b < 4; ++b) {
+                h ^= (p >> (b * 8)) & 0xFF;
+                h *= 0x100000001b3ull;
+            }
+        }
+    }
+    return h;
+}
+
+// Compare an image with its golden digest. On a mismatch the image is
+// written to <name>.pam (RGBA, viewable with most image tools) and the new
+// digest is printed.
+inline bool golden(const char* name, const uint32_t* px, int width,
+                   int height, int stride, uint64_t expected) {
+    uint64_t got = digest(px, width, height, stride);
+    if (got == expected) return true;
+    std::printf("golden %s: digest 0x%016llxull, expected 0x%016llxull\n",
+                name, static_cast<unsigned long long>(got),
+                static_cast<unsigned long long>(expected));
+    std::string path = std::string(name) + ".pam";
+    if (FILE* f = std::fopen(path.c_str(), "wb")) {
+        std::fprintf(f, "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 4\nMAXVAL 255\n"
+                        "TUPLTYPE RGB_ALPHA\nENDHDR\n", width, height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                uint32_t p = px[y * stride + x];
+                unsigned char rgba[4] = {
+                    static_cast<unsigned char>(p >> 16),
+                    static_cast<unsigned char>(p >> 8),
+                    static_cast<unsigned char>(p),
+                    static_cast<unsigned char>(p >> 24),
+                };
+                std::fwrite(rgba, 1, 4, f);
+            }
+        }
+        std::fclose(f);
+    }
+    return false;
+}
+
+}  // namespace check
+
+#define CHECK(cond) \
+    do { if (!(cond)) check::fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { if (!((a) == (b))) check::fail(__FILE__, __LINE__, #a " == " #b); } \
+    while (0)
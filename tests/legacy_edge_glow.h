@@ -0,0 +1,42 @@
+#pragma once
+#include "render.h"
+#include <algorithm>
+#include <cstdint>
+
+// The per-pixel edge glow the LUT renderer replaced (edge_flash.cpp before
+// render::edge_glow), kept as the reference its output must match
+namespace legacy {
+
+inline uint32_t glow_pixel(int dist) {
+    constexpr float kR = 0.0f;
+    constexpr float kG = 140.0f / 255.0f;
+    constexpr float kB = 180.0f / 255.0f;
+    float t = static_cast<float>(dist) / render::kEdgeGlowWidth;
+    float s = 1.0f - t;
+    float a = s * s * s;
+
+    auto to_byte = [](float v) -> uint32_t {
+        return static_cast<uint32_t>(v * 255.0f);
+    };
+    return (to_byte(a) << 24) |
+           (to_byte(kR * a) << 16) |
+           (to_byte(kG * a) << 8) |
+           to_byte(kB * a);
+}
+
+// Canvas at (left, top) on an sw x sh screen
+inline void edge_glow(const render::Canvas& c, int left, int top, int sw,
+                      int sh) {
+    int gw = std::min(render::kEdgeGlowWidth, std::min(sw / 2, sh / 2));
+    for (int y = top; y < top + c.height; ++y) {
+        uint32_t* row = c.pixels + (y - top) * c.stride - left;
+        int dy = std::min(y, sh - 1 - y);
+        for (int x = left; x < left + c.width; ++x) {
+            int dx = std::min(x, sw - 1 - x);
+            int d = std::min(dx, dy);
+            row[x] = (d < gw) ? glow_pixel(d) : 0;
+        }
+    }
+}
+
+}  // namespace legacy
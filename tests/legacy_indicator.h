@@ -0,0 +1,99 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// The indicator's per-pixel loop that sdf_raster replaced (indicator.cpp
+// before sdf_raster::render), kept as the reference its 32 px output must
+// match
+namespace legacy {
+
+constexpr int kIndicatorSize = 32;
+
+inline float sdf_hexagon(float px, float py, float r) {
+    constexpr float k = 0.8660254f;  // sqrt(3)/2
+    float ax = std::abs(px);
+    float ay = std::abs(py);
+    return std::max(ax * 0.5f + ay * k, ax) - r;
+}
+
+inline float sdf_diamond(float px, float py, float r) {
+    return (std::abs(px) + std::abs(py)) - r;
+}
+
+inline void composite_over(float sr, float sg, float sb, float sa,
+                           float& dr, float& dg, float& db, float& da) {
+    float inv = 1.0f - sa;
+    dr = sr * sa + dr * inv;
+    dg = sg * sa + dg * inv;
+    db = sb * sa + db * inv;
+    da = sa + da * inv;
+}
+
+// kIndicatorSize x kIndicatorSize premultiplied BGRA pixels
+inline void indicator(uint32_t* pixels, float breath, float spin_angle) {
+    constexpr float kAccentR = 0.0f;
+    constexpr float kAccentG = 0.831f;
+    constexpr float kAccentB = 1.0f;
+    constexpr float kBodyR = 0.102f;
+    constexpr float kBodyG = 0.102f;
+    constexpr float kBodyB = 0.180f;
+    constexpr int kSize = kIndicatorSize;
+
+    float hex_cos = std::cos(spin_angle);
+    float hex_sin = std::sin(spin_angle);
+    float dia_cos = std::cos(-spin_angle);
+    float dia_sin = std::sin(-spin_angle);
+
+    float cx = kSize * 0.5f;
+    float cy = kSize * 0.5f;
+
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            float px = x + 0.5f - cx;
+            float py = y + 0.5f - cy;
+
+            float hpx = px * hex_cos - py * hex_sin;
+            float hpy = px * hex_sin + py * hex_cos;
+            float dpx = px * dia_cos - py * dia_sin;
+            float dpy = px * dia_sin + py * dia_cos;
+
+            float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+
+            float dist = std::sqrt(px * px + py * py);
+            float glow_inner = 10.7f;
+            float glow_outer = 15.3f;
+            if (dist < glow_outer) {
+                float t = std::clamp((dist - glow_inner) / (glow_outer - glow_inner), 0.0f, 1.0f);
+                float glow_a = (1.0f - t * t) * 0.6f * breath;
+                composite_over(kAccentR, kAccentG, kAccentB, glow_a, r, g, b, a);
+            }
+
+            float hex_d = sdf_hexagon(hpx, hpy, 12.0f);
+            float hex_a = std::clamp(-hex_d + 0.5f, 0.0f, 1.0f);
+            if (hex_a > 0.0f)
+                composite_over(kBodyR, kBodyG, kBodyB, hex_a, r, g, b, a);
+
+            float ring_d = std::abs(sdf_hexagon(hpx, hpy, 10.0f)) - 0.5f;
+            float ring_a = std::clamp(-ring_d + 0.5f, 0.0f, 1.0f) * breath;
+            if (ring_a > 0.0f)
+                composite_over(kAccentR, kAccentG, kAccentB, ring_a, r, g, b, a);
+
+            float diamond_d = sdf_diamond(dpx, dpy, 4.0f);
+            float diamond_a = std::clamp(-diamond_d + 0.5f, 0.0f, 1.0f);
+            if (diamond_a > 0.0f)
+                composite_over(kAccentR, kAccentG, kAccentB, diamond_a, r, g, b, a);
+
+            auto to_byte = [](float v) -> uint8_t {
+                return static_cast<uint8_t>(std::clamp(v * 255.0f, 0.0f, 255.0f));
+            };
+            pixels[y * kSize + x] =
+                (static_cast<uint32_t>(to_byte(a)) << 24) |
+                (static_cast<uint32_t>(to_byte(r)) << 16) |
+                (static_cast<uint32_t>(to_byte(g)) << 8) |
+                static_cast<uint32_t>(to_byte(b));
+        }
+    }
+}
+
+}  // namespace legacy
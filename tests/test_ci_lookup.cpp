@@ -0,0 +1,91 @@
+#include "check.h"
+#include "ci_lookup.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+constexpr std::wstring_view kColors[] = {L"red", L"Green", L"BLUE"};
+constexpr auto kColorSet = ci_lookup::make_set(kColors);
+static_assert(kColorSet.contains(L"RED") && kColorSet.contains(L"blue"));
+static_assert(!kColorSet.contains(L"cyan") && !kColorSet.contains(L""));
+
+constexpr auto kNumbers = ci_lookup::make_map<int>({{L"one", 1}, {L"Two", 2}});
+static_assert(*kNumbers.find(L"TWO") == 2 && !kNumbers.find(L"three"));
+
+std::wstring random_key(std::mt19937& rng) {
+    std::uniform_int_distribution<int> len(1, 24);
+    std::uniform_int_distribution<int> ch(0, 37);
+    std::wstring s;
+    for (int i = len(rng); i > 0; --i) {
+        int c = ch(rng);
+        s += c < 26 ? static_cast<wchar_t>(L'a' + c)
+           : c < 36 ? static_cast<wchar_t>(L'0' + c - 26)
+           : c == 36 ? L'_' : L'.';
+    }
+    return s;
+}
+
+std::wstring upper(std::wstring s) {
+    for (auto& c : s) {
+        if (c >= L'a' && c <= L'z') c = static_cast<wchar_t>(c - L'a' + L'A');
+    }
+    return s;
+}
+
+// n distinct random keys: every key (in either case) is found, nothing else
+void test_random_set(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::unordered_set<std::wstring> unique;
+    std::vector<std::wstring> storage;
+    while (storage.size() < n) {
+        std::wstring k = random_key(rng);
+        if (unique.insert(k).second) storage.push_back(k);
+    }
+    std::vector<std::wstring_view> keys(storage.begin(), storage.end());
+
+    auto set = std::make_unique<ci_lookup::Set<2048>>();
+    CHECK(set->build(keys.data(), keys.size()));
+    CHECK_EQ(set->size(), n);
+
+    size_t missed = 0;
+    for (const auto& k : storage) {
+        missed += !set->contains(k);
+        missed += !set->contains(upper(k));
+    }
+    CHECK_EQ(missed, 0u);
+
+    size_t false_positives = 0;
+    for (int i = 0; i < 20000; ++i) {
+        std::wstring k = random_key(rng);
+        if (!unique.count(k)) false_positives += set->contains(k);
+    }
+    CHECK_EQ(false_positives, 0u);
+}
+
+void test_runtime_edge_cases() {
+    auto set = std::make_unique<ci_lookup::Set<8>>();
+    std::wstring_view dupes[] = {L"App", L"", L"app", L"APP", L"other"};
+    CHECK(set->build(dupes, std::size(dupes)));
+    CHECK_EQ(set->size(), 2u);  // empty key and later duplicates dropped
+    CHECK(set->contains(L"aPp") && set->contains(L"OTHER"));
+    CHECK(!set->contains(L""));
+
+    std::wstring_view many[9] = {L"a", L"b", L"c", L"d", L"e",
+                                 L"f", L"g", L"h", L"i"};
+    CHECK(!set->build(many, 9));  // over capacity leaves the set empty
+    CHECK_EQ(set->size(), 0u);
+    CHECK(!set->contains(L"a"));
+}
+
+}  // namespace
+
+int main() {
+    unsigned seed = 1;
+    for (size_t n : {14u, 200u, 1000u, 1024u, 2000u}) test_random_set(n, seed++);
+    test_runtime_edge_cases();
+    return check::result();
+}
@@ -0,0 +1,17 @@
+#include "check.h"
+#include "display_name.h"
+
+int main() {
+    using display_name::from_path;
+    CHECK(from_path(L"C:\\Program Files\\Microsoft VS Code\\Code.exe")
+          == L"VS Code");
+    CHECK(from_path(L"C:\\Windows\\EXPLORER.EXE") == L"Explorer");
+    CHECK(from_path(L"C:\\Tools\\wt.exe") == L"Terminal");
+    // Unmapped names keep their case
+    CHECK(from_path(L"D:\\Apps\\MyTool.exe") == L"MyTool");
+    CHECK(from_path(L"D:\\Apps\\no_extension") == L"no_extension");
+    CHECK(from_path(L"D:\\Apps\\archive.tar.exe") == L"archive.tar");
+    CHECK(from_path(L"notepad.exe") == L"Notepad");
+    CHECK(from_path(L"") == L"");
+    return check::result();
+}
@@ -0,0 +1,51 @@
+// render::edge_glow must reproduce the per-pixel renderer bit for bit,
+// for the full-screen window and for each of the four edge windows
+#include "check.h"
+#include "legacy_edge_glow.h"
+#include <vector>
+
+namespace {
+
+struct Rect { int left, top, right, bottom; };
+
+// Same split as edge_flash's Edges mode
+std::vector<Rect> edge_windows(int sw, int sh) {
+    int gw = render::edge_glow_width(sw, sh);
+    std::vector<Rect> r = {{0, 0, sw, gw}, {0, sh - gw, sw, sh}};
+    if (sh - 2 * gw > 0) {
+        r.push_back({0, gw, gw, sh - gw});
+        r.push_back({sw - gw, gw, sw, sh - gw});
+    }
+    return r;
+}
+
+bool matches_legacy(Rect rc, int sw, int sh) {
+    int w = rc.right - rc.left;
+    int h = rc.bottom - rc.top;
+    // Poisoned so unwritten pixels show up
+    std::vector<uint32_t> want(w * h, 0xDEADBEEF), got(w * h, 0xDEADBEEF);
+    legacy::edge_glow({want.data(), w, h, w}, rc.left, rc.top, sw, sh);
+    render::edge_glow({got.data(), w, h, w}, rc.left, rc.top, sw, sh);
+    return want == got;
+}
+
+}  // namespace
+
+int main() {
+    struct Screen { int w, h; };
+    constexpr Screen kScreens[] = {
+        {1920, 1080}, {2560, 1440}, {3840, 2160}, {81, 79}, {50, 30}, {7, 5}};
+    for (Screen s : kScreens) {
+        if (!matches_legacy({0, 0, s.w, s.h}, s.w, s.h))
+            std::printf("full screen %dx%d differs\n", s.w, s.h);
+        CHECK(matches_legacy({0, 0, s.w, s.h}, s.w, s.h));
+        for (Rect rc : edge_windows(s.w, s.h)) {
+            if (rc.right <= rc.left || rc.bottom <= rc.top) continue;
+            if (!matches_legacy(rc, s.w, s.h))
+                std::printf("%dx%d edge (%d,%d)-(%d,%d) differs\n", s.w, s.h,
+                            rc.left, rc.top, rc.right, rc.bottom);
+            CHECK(matches_legacy(rc, s.w, s.h));
+        }
+    }
+    return check::result();
+}
@@ -0,0 +1,150 @@
+// fuzzy_match::score on hand-checked cases, and the incremental Matcher
+// against ranking every candidate from scratch over random push / pop
+// sequences
+#include "check.h"
+#include "fuzzy_match.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fuzzy_match::Candidate;
+using fuzzy_match::score;
+
+constexpr int kNameBonus = 8;  // fuzzy_match.cpp
+
+void test_score() {
+    CHECK_EQ(score(L"", L"anything"), 0);
+    CHECK_EQ(score(L"", L""), 0);
+    CHECK_EQ(score(L"a", L""), -1);
+    CHECK_EQ(score(L"ba", L"ab"), -1);  // order matters
+    CHECK_EQ(score(L"abc", L"ab"), -1);
+
+    // 16 per character, +10 at a word start, +12 right after the previous
+    // match, -1 per skipped character
+    CHECK_EQ(score(L"ab", L"ab"), 16 + 10 + 16 + 12);
+    CHECK_EQ(score(L"ab", L"xaxb"), 16 + 16 - 1);
+    CHECK_EQ(score(L"fb", L"fooBar"), 16 + 10 + 16 + 10 - 2);
+    CHECK_EQ(score(L"vc", L"Visual-Code"), 16 + 10 + 16 + 10 - 6);
+    // The gap penalty is capped
+    std::wstring far = L"a" + std::wstring(100, L'x') + L"b";
+    CHECK_EQ(score(L"ab", far), 16 + 10 + 16 - 24);
+
+    // ASCII case-insensitive either way round
+    CHECK_EQ(score(L"CODE", L"code"), score(L"code", L"CODE"));
+    CHECK(score(L"code", L"VS Code") > 0);
+
+    // The best start wins, not the first one
+    CHECK(score(L"te", L"the terminal") > score(L"te", L"the xxxxxxx"));
+    CHECK(score(L"term", L"xterm Terminal") == score(L"term", L"Terminal"));
+
+    // Word starts and runs rank above scattered matches
+    CHECK(score(L"vsc", L"VS Code") > score(L"vsc", L"avisco"));
+    CHECK(score(L"note", L"Notepad") > score(L"note", L"nxoxtxe"));
+}
+
+void test_matcher() {
+    std::vector<Candidate> c = {
+        {L"Chrome", L"Inbox - Mail"},
+        {L"VS Code", L"main.cpp - repo"},
+        {L"Terminal", L"cmd"},
+        {L"Notepad", L"chrome notes.txt"},
+    };
+    fuzzy_match::Matcher m;
+    m.set_candidates(c);
+    CHECK(m.pattern().empty());
+    CHECK((std::vector<int>(m.results().begin(), m.results().end())
+           == std::vector<int>{0, 1, 2, 3}));
+
+    CHECK(m.push(L'c'));
+    CHECK(m.push(L'h'));
+    // Both match "ch"; the display name outranks the caption
+    CHECK((std::vector<int>(m.results().begin(), m.results().end())
+           == std::vector<int>{0, 3}));
+
+    CHECK(!m.push(L'z'));  // no match: ignored
+    CHECK(m.pattern() == L"ch");
+    CHECK(m.pop());
+    CHECK(m.pattern() == L"c");
+    CHECK(m.pop());
+    CHECK(!m.pop());
+    CHECK_EQ(m.results().size(), c.size());
+
+    m.push(L'x');
+    m.set_candidates(c);  // resets the pattern
+    CHECK(m.pattern().empty());
+
+    m.set_candidates({});
+    CHECK(!m.push(L'a'));
+    CHECK(m.results().empty());
+}
+
+// Matcher results for pattern, computed from scratch
+std::vector<int> reference(const std::vector<Candidate>& c,
+                           const std::wstring& pattern) {
+    std::vector<std::pair<int, int>> scored;
+    for (int i = 0; i < static_cast<int>(c.size()); ++i) {
+        int by_name = score(pattern, c[i].name);
+        int s = std::max(by_name >= 0 ? by_name + kNameBonus : -1,
+                         score(pattern, c[i].caption));
+        if (s >= 0) scored.push_back({i, s});
+    }
+    std::stable_sort(scored.begin(), scored.end(),
+                     [](auto& a, auto& b) { return a.second > b.second; });
+    std::vector<int> out;
+    for (auto& s : scored) out.push_back(s.first);
+    return out;
+}
+
+void test_matcher_against_reference() {
+    std::mt19937 rng(23);
+    auto word = [&](int max_len) {
+        std::wstring s;
+        for (int i = 1 + static_cast<int>(rng() % max_len); i > 0; --i) {
+            int k = static_cast<int>(rng() % 40);
+            s += k < 12 ? static_cast<wchar_t>(L'a' + k % 6)
+               : k < 18 ? static_cast<wchar_t>(L'A' + k % 6)
+               : k < 21 ? L' ' : k < 22 ? L'-' : static_cast<wchar_t>(L'g' + k % 20);
+        }
+        return s;
+    };
+
+    for (int round = 0; round < 50; ++round) {
+        std::vector<std::wstring> text;
+        int n = 1 + static_cast<int>(rng() % 60);
+        for (int i = 0; i < 2 * n; ++i) text.push_back(word(i % 2 ? 40 : 12));
+        std::vector<Candidate> c;
+        for (int i = 0; i < n; ++i) c.push_back({text[2 * i], text[2 * i + 1]});
+
+        fuzzy_match::Matcher m;
+        m.set_candidates(c);
+        std::wstring pattern;
+        bool ok = true;
+        for (int step = 0; step < 40; ++step) {
+            if (rng() % 4 == 0) {
+                CHECK_EQ(m.pop(), !pattern.empty());
+                if (!pattern.empty()) pattern.pop_back();
+            } else {
+                wchar_t ch = static_cast<wchar_t>(L'a' + rng() % 8);
+                bool any = !reference(c, pattern + ch).empty();
+                CHECK_EQ(m.push(ch), any);
+                if (any) pattern += ch;
+            }
+            ok &= m.pattern() == pattern;
+            ok &= std::vector<int>(m.results().begin(), m.results().end())
+                  == reference(c, pattern);
+        }
+        CHECK(ok);
+    }
+}
+
+}  // namespace
+
+int main() {
+    test_score();
+    test_matcher();
+    test_matcher_against_reference();
+    return check::result();
+}
@@ -0,0 +1,248 @@
+// key_engine::Engine fed synthetic key streams: chords, leader sequences,
+// timeouts, wrong keys, auto-repeat and a wrapping millisecond clock
+#include "check.h"
+#include "key_engine.h"
+#include <cstdint>
+
+namespace {
+
+using key_engine::Pattern;
+using key_engine::Result;
+
+// Win32 virtual-key codes
+constexpr uint8_t kLCtrl = 0xA2;
+constexpr uint8_t kLAlt = 0xA4;
+constexpr uint8_t kSpace = 0x20;
+constexpr uint8_t kG = 'G';
+constexpr uint8_t kK = 'K';
+constexpr uint8_t kL = 'L';
+constexpr uint8_t kQ = 'Q';
+constexpr uint8_t kW = 'W';
+constexpr uint8_t kX = 'X';
+
+constexpr uint8_t kCtrlAlt = key_engine::kCtrl | key_engine::kAlt;
+
+enum : int { kChordKL, kLeaderG, kLeaderWQ };
+
+constexpr Pattern kPatterns[] = {
+    // Ctrl+Alt+K+L held together
+    {{{kCtrlAlt, {kK, kL}}}},
+    // Ctrl+Space, then G
+    {{{key_engine::kCtrl, {kSpace}}, {0, {kG}}}},
+    // Ctrl+Space, then W, then Q
+    {{{key_engine::kCtrl, {kSpace}}, {0, {kW}}, {0, {kQ}}}},
+};
+
+// An engine with a clock that moves 10 ms per event unless told otherwise
+struct Stream {
+    key_engine::Engine engine;
+    uint32_t now = 5000;
+    uint32_t stroke = 0;  // time of the last leader key-down
+
+    Stream() { engine.set_patterns(kPatterns); }
+
+    Result down(uint8_t vk, uint32_t gap_ms = 10) {
+        now += gap_ms;
+        return engine.on_key(vk, true, now);
+    }
+    Result up(uint8_t vk, uint32_t gap_ms = 10) {
+        now += gap_ms;
+        return engine.on_key(vk, false, now);
+    }
+    // Key-down ms after the last leader stroke
+    Result down_after_stroke(uint8_t vk, uint32_t ms) {
+        return down(vk, stroke + ms - now);
+    }
+    // Ctrl+Space as the first stroke of both leader patterns
+    void leader() {
+        down(kLCtrl);
+        Result r = down(kSpace);
+        stroke = now;
+        CHECK(r.swallow && r.fired < 0);
+        up(kSpace);
+        up(kLCtrl);
+        CHECK_EQ(engine.sequence_position(), 1);
+    }
+};
+
+void test_modifiers_pass_through() {
+    Stream s;
+    for (uint8_t vk : {kLCtrl, kLAlt}) {
+        Result r = s.down(vk);
+        CHECK(!r.swallow && r.fired < 0);
+    }
+    for (uint8_t vk : {kLAlt, kLCtrl}) CHECK(!s.up(vk).swallow);
+}
+
+void test_chord() {
+    Stream s;
+    s.down(kLCtrl);
+    s.down(kLAlt);
+    Result r = s.down(kK);
+    CHECK(r.swallow && r.mask_menu && r.fired < 0);  // chord incomplete
+    r = s.down(kL);
+    CHECK(r.swallow && r.mask_menu);
+    CHECK_EQ(r.fired, kChordKL);
+    CHECK(s.up(kL).swallow);
+    CHECK(s.up(kK).swallow);
+    CHECK(!s.up(kLAlt).swallow);
+    CHECK(!s.up(kLCtrl).swallow);
+
+    // Either order
+    s.down(kLCtrl);
+    s.down(kLAlt);
+    s.down(kL);
+    CHECK_EQ(s.down(kK).fired, kChordKL);
+    s.up(kK);
+    s.up(kL);
+
+    // Wrong modifier set: not ours at all
+    s.up(kLAlt);
+    r = s.down(kK);
+    CHECK(!r.swallow && r.fired < 0);
+    CHECK(!s.up(kK).swallow);
+    s.up(kLCtrl);
+
+    // A chord key released early is lost; the chord does not fire later
+    s.down(kLCtrl);
+    s.down(kLAlt);
+    CHECK(s.down(kK).swallow);
+    CHECK(s.up(kK).swallow);
+    r = s.down(kL);
+    CHECK(r.swallow && r.fired < 0);
+    s.up(kL);
+    s.up(kLAlt);
+    s.up(kLCtrl);
+}
+
+void test_leader_sequence() {
+    Stream s;
+    s.leader();
+    Result r = s.down(kG);
+    CHECK(r.swallow && !r.mask_menu);
+    CHECK_EQ(r.fired, kLeaderG);
+    CHECK(s.up(kG).swallow);
+    CHECK_EQ(s.engine.sequence_position(), 0);
+
+    // Three strokes
+    s.leader();
+    r = s.down(kW);
+    CHECK(r.swallow && r.fired < 0);
+    s.up(kW);
+    CHECK_EQ(s.engine.sequence_position(), 2);
+    CHECK_EQ(s.down(kQ).fired, kLeaderWQ);
+    s.up(kQ);
+
+    // A plain G outside a sequence is not ours
+    r = s.down(kG);
+    CHECK(!r.swallow && r.fired < 0);
+    CHECK(!s.up(kG).swallow);
+}
+
+void test_timeout() {
+    Stream s;
+    s.leader();
+    // A gap of exactly the limit is still in time
+    CHECK_EQ(s.down_after_stroke(kG, key_engine::kSequenceTimeoutMs).fired,
+             kLeaderG);
+    s.up(kG);
+
+    s.leader();
+    Result r = s.down_after_stroke(kG, key_engine::kSequenceTimeoutMs + 1);
+    CHECK(!r.swallow && r.fired < 0);  // sequence dropped, G passes through
+    CHECK_EQ(s.engine.sequence_position(), 0);
+    CHECK(!s.up(kG).swallow);
+
+    // The gap counts from the last stroke, not from the first
+    s.leader();
+    s.down(kW, 900);
+    s.up(kW);
+    CHECK_EQ(s.down(kQ, 900).fired, kLeaderWQ);
+    s.up(kQ);
+}
+
+void test_wrong_key() {
+    Stream s;
+    s.leader();
+    Result r = s.down(kX);
+    CHECK(r.swallow && r.fired < 0);  // ends the sequence, swallowed
+    CHECK_EQ(s.engine.sequence_position(), 0);
+    CHECK(s.up(kX).swallow);
+    r = s.down(kG);
+    CHECK(!r.swallow && r.fired < 0);
+    s.up(kG);
+
+    // Wrong key after a second stroke
+    s.leader();
+    s.down(kW);
+    s.up(kW);
+    CHECK(s.down(kG).swallow);
+    CHECK_EQ(s.engine.sequence_position(), 0);
+    s.up(kG);
+}
+
+void test_auto_repeat() {
+    Stream s;
+    s.leader();
+    CHECK_EQ(s.down(kG).fired, kLeaderG);
+    for (int i = 0; i < 20; ++i) {
+        Result r = s.down(kG, 33);
+        CHECK(r.swallow && r.fired < 0);  // repeats follow the first press
+    }
+    CHECK(s.up(kG).swallow);
+
+    // Repeats of a key that was passed through are passed through too
+    CHECK(!s.down(kX).swallow);
+    for (int i = 0; i < 20; ++i) CHECK(!s.down(kX, 33).swallow);
+    CHECK(!s.up(kX).swallow);
+
+    // Holding the leader key does not restart or advance the sequence
+    s.down(kLCtrl);
+    s.down(kSpace);
+    for (int i = 0; i < 5; ++i) s.down(kSpace, 33);
+    s.up(kSpace);
+    s.up(kLCtrl);
+    CHECK_EQ(s.engine.sequence_position(), 1);
+    CHECK_EQ(s.down(kG).fired, kLeaderG);
+    s.up(kG);
+}
+
+void test_clock_wrap() {
+    Stream s;
+    s.now = UINT32_MAX - 25;
+    s.leader();  // the stroke lands just before the wrap
+    CHECK(s.now < s.stroke);
+    CHECK_EQ(s.down_after_stroke(kG, key_engine::kSequenceTimeoutMs).fired,
+             kLeaderG);
+    s.up(kG);
+
+    s.now = UINT32_MAX - 25;
+    s.leader();
+    Result r = s.down_after_stroke(kG, key_engine::kSequenceTimeoutMs + 1);
+    CHECK(!r.swallow && r.fired < 0);
+    s.up(kG);
+}
+
+void test_reset() {
+    Stream s;
+    s.leader();
+    s.down(kLCtrl);
+    s.engine.reset();
+    CHECK_EQ(s.engine.sequence_position(), 0);
+    Result r = s.down(kG);  // Ctrl is no longer considered held
+    CHECK(!r.swallow && r.fired < 0);
+}
+
+}  // namespace
+
+int main() {
+    test_modifiers_pass_through();
+    test_chord();
+    test_leader_sequence();
+    test_timeout();
+    test_wrong_key();
+    test_auto_repeat();
+    test_clock_wrap();
+    test_reset();
+    return check::result();
+}
@@ -0,0 +1,96 @@
+// mru_ring::Ring against a std::deque model (most recent first, capped at
+// Capacity) over a long random stream of touches and erases
+#include "check.h"
+#include "mru_ring.h"
+#include <algorithm>
+#include <deque>
+#include <random>
+
+namespace {
+
+template <size_t Capacity>
+struct Model {
+    std::deque<int> keys;
+
+    void touch(int key) {
+        auto it = std::find(keys.begin(), keys.end(), key);
+        if (it != keys.end()) keys.erase(it);
+        keys.push_front(key);
+        if (keys.size() > Capacity) keys.pop_back();
+    }
+    void erase(int key) {
+        auto it = std::find(keys.begin(), keys.end(), key);
+        if (it != keys.end()) keys.erase(it);
+    }
+    int rank(int key) const {
+        auto it = std::find(keys.begin(), keys.end(), key);
+        return it == keys.end() ? -1 : static_cast<int>(it - keys.begin());
+    }
+};
+
+template <size_t Capacity>
+bool same(const mru_ring::Ring<int, Capacity>& ring,
+          const Model<Capacity>& model) {
+    if (ring.size() != model.keys.size()) return false;
+    for (size_t i = 0; i < ring.size(); ++i) {
+        if (ring[i] != model.keys[i]) return false;
+    }
+    return true;
+}
+
+void test_basics() {
+    mru_ring::Ring<int, 4> r;
+    CHECK_EQ(r.size(), 0u);
+    CHECK_EQ(r.rank(1), -1);
+    for (int k : {1, 2, 3}) r.touch(k);
+    CHECK(r[0] == 3 && r[1] == 2 && r[2] == 1);
+    r.touch(1);  // moves to the front
+    CHECK(r[0] == 1 && r[1] == 3 && r[2] == 2);
+    CHECK_EQ(r.rank(2), 2);
+    r.touch(4);
+    r.touch(5);  // full: the least recent (2) drops out
+    CHECK_EQ(r.size(), 4u);
+    CHECK_EQ(r.rank(2), -1);
+    CHECK(r[0] == 5 && r[3] == 3);
+    r.erase(4);
+    r.erase(42);  // absent: no-op
+    CHECK_EQ(r.size(), 3u);
+    CHECK(r[0] == 5 && r[1] == 1 && r[2] == 3);
+}
+
+// Keys drawn from a range a bit wider than the ring, so touches hit
+// present keys, evict and re-insert
+template <size_t Capacity>
+void test_against_model(int steps, int key_range, unsigned seed) {
+    std::mt19937 rng(seed);
+    mru_ring::Ring<int, Capacity> ring;
+    Model<Capacity> model;
+    int first_bad = -1;
+    for (int step = 0; step < steps && first_bad < 0; ++step) {
+        int key = static_cast<int>(rng() % key_range);
+        if (rng() % 5 == 0) {
+            ring.erase(key);
+            model.erase(key);
+        } else {
+            ring.touch(key);
+            model.touch(key);
+        }
+        int probe = static_cast<int>(rng() % key_range);
+        if (!same(ring, model) || ring.rank(probe) != model.rank(probe))
+            first_bad = step;
+    }
+    if (first_bad >= 0)
+        std::printf("capacity %zu: differs at step %d\n", Capacity, first_bad);
+    CHECK_EQ(first_bad, -1);
+}
+
+}  // namespace
+
+int main() {
+    test_basics();
+    test_against_model<1>(200000, 3, 1);
+    test_against_model<8>(200000, 12, 2);
+    test_against_model<64>(200000, 80, 3);
+    test_against_model<64>(200000, 20, 4);  // never fills: erase paths
+    return check::result();
+}
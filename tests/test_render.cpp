@@ -0,0 +1,159 @@
+// Golden images for the portable renderers
+#include "check.h"
+#include "render.h"
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+struct IndicatorCase {
+    int size;
+    uint64_t elapsed_ms;
+    uint64_t spin_ms;
+    uint64_t golden;
+};
+
+constexpr IndicatorCase kIndicator[] = {
+    {32, 0, render::kSpinDurationMs, 0x84f7c8e1db47f695ull},
+    {32, 900, render::kSpinDurationMs, 0x8b5dab14b4731afdull},
+    {32, 2500, 300, 0x68b2e48083e72cc1ull},
+    {64, 1700, 600, 0x2c5ffc509f0c9e9dull},
+    {128, 400, 1000, 0xc60cf3c1569b6361ull},
+};
+
+void test_indicator() {
+    for (const auto& t : kIndicator) {
+        std::vector<uint32_t> px(t.size * t.size);
+        render::indicator({px.data(), t.size, t.size, t.size}, t.elapsed_ms,
+                          t.spin_ms);
+        char name[64];
+        std::snprintf(name, sizeof(name), "indicator_%d_%llu_%llu", t.size,
+                      static_cast<unsigned long long>(t.elapsed_ms),
+                      static_cast<unsigned long long>(t.spin_ms));
+        CHECK(check::golden(name, px.data(), t.size, t.size, t.size,
+                            t.golden));
+    }
+}
+
+// Whole 160 x 100 screen, then each edge window must match its part of it
+void test_edge_glow() {
+    constexpr int kW = 160;
+    constexpr int kH = 100;
+    std::vector<uint32_t> screen(kW * kH);
+    render::edge_glow({screen.data(), kW, kH, kW}, 0, 0, kW, kH);
+    CHECK(check::golden("edge_glow_160x100", screen.data(), kW, kH, kW,
+                        0xf8f5df5b9929396dull));
+
+    int g = render::edge_glow_width(kW, kH);
+    CHECK_EQ(g, render::kEdgeGlowWidth);
+    struct Part { int x, y, w, h; };
+    const Part parts[] = {
+        {0, 0, kW, g}, {0, kH - g, kW, g},              // top, bottom
+        {0, g, g, kH - 2 * g}, {kW - g, g, g, kH - 2 * g},  // left, right
+    };
+    for (const Part& p : parts) {
+        std::vector<uint32_t> px(p.w * p.h);
+        render::edge_glow({px.data(), p.w, p.h, p.w}, p.x, p.y, kW, kH);
+        bool same = true;
+        for (int y = 0; y < p.h; ++y) {
+            for (int x = 0; x < p.w; ++x)
+                same &= px[y * p.w + x] == screen[(p.y + y) * kW + p.x + x];
+        }
+        CHECK(same);
+    }
+
+    // A screen smaller than two glow widths narrows the glow
+    CHECK_EQ(render::edge_glow_width(50, 30), 15);
+}
+
+// Three chips on a 2-layer synthetic atlas: normal chips are a horizontal
+// ramp, selected ones a vertical ramp
+struct Panel {
+    static constexpr int kW = 200;
+    static constexpr int kItemH = 20;
+    static constexpr int kH = 26;
+    static constexpr uint32_t kBg = 0xFF1A1A2E;
+    std::vector<uint32_t> atlas = std::vector<uint32_t>(kW * kH * 2);
+    std::vector<uint32_t> pixels = std::vector<uint32_t>(kW * kH);
+    render::Chip chips[3] = {{4, 3, 60}, {66, 3, 50}, {118, 3, 78}};
+
+    Panel() {
+        for (int y = 0; y < kH; ++y) {
+            for (int x = 0; x < kW; ++x) {
+                atlas[y * kW + x] = 0xFF000000 | (x << 8) | 0x40;
+                atlas[(kH + y) * kW + x] = 0xFF000000 | (y * 9 << 16) | 0xB4;
+            }
+        }
+    }
+    render::Canvas canvas() { return {pixels.data(), kW, kH, kW}; }
+    render::ChipSheet sheet() {
+        return {atlas.data(), kW, chips, kItemH, kH, kBg};
+    }
+};
+
+void test_switcher_panel() {
+    Panel p;
+    uint32_t total = render::switcher_intro_ms(3);
+    CHECK_EQ(total, render::kChipAnimMs + 2 * render::kChipStaggerMs);
+
+    struct Frame { uint64_t elapsed_ms; int slide; uint64_t golden; };
+    const Frame frames[] = {
+        {0, render::kSlideDistance, 0xfa2765402f613ba5ull},
+        {150, 2, 0xf9526aac6dedb775ull},
+        {350, 0, 0x1806dff301e634ddull},
+        {total, 0, 0xa73f1eb996c6453dull},
+    };
+    for (const Frame& f : frames) {
+        int dy = render::switcher_panel(p.canvas(), p.sheet(), 1,
+                                        f.elapsed_ms);
+        CHECK_EQ(dy, f.slide);
+        char name[64];
+        std::snprintf(name, sizeof(name), "switcher_panel_%llu",
+                      static_cast<unsigned long long>(f.elapsed_ms));
+        CHECK(check::golden(name, p.pixels.data(), Panel::kW, Panel::kH,
+                            Panel::kW, f.golden));
+    }
+
+    // The final frame is the background with every chip copied verbatim
+    // from its layer
+    bool exact = true;
+    for (int y = 0; y < Panel::kH; ++y) {
+        for (int x = 0; x < Panel::kW; ++x) {
+            uint32_t want = Panel::kBg;
+            for (int i = 0; i < 3; ++i) {
+                const render::Chip& c = p.chips[i];
+                if (x >= c.x && x < c.x + c.width && y >= c.y
+                    && y < c.y + Panel::kItemH) {
+                    int layer = (i == 1) ? Panel::kH : 0;
+                    want = p.atlas[(layer + y) * Panel::kW + x];
+                }
+            }
+            exact &= p.pixels[y * Panel::kW + x] == want;
+        }
+    }
+    CHECK(exact);
+
+    // Nothing has faded in on the first frame
+    render::switcher_panel(p.canvas(), p.sheet(), 1, 0);
+    bool blank = true;
+    for (uint32_t px : p.pixels) blank &= px == Panel::kBg;
+    CHECK(blank);
+    render::switcher_panel(p.canvas(), p.sheet(), 1, total);
+
+    // Moving the cursor repaints just the two chips, landing on the same
+    // image as a full frame with the new cursor
+    render::switcher_chip(p.canvas(), p.sheet(), 1, 2);
+    render::switcher_chip(p.canvas(), p.sheet(), 2, 2);
+    std::vector<uint32_t> moved = p.pixels;
+    render::switcher_panel(p.canvas(), p.sheet(), 2, total);
+    CHECK(moved == p.pixels);
+}
+
+}  // namespace
+
+int main() {
+    test_indicator();
+    test_edge_glow();
+    test_switcher_panel();
+    return check::result();
+}
@@ -0,0 +1,72 @@
+// At 32 px every ISA must reproduce the old per-pixel indicator loop bit for
+// bit; at scaled sizes the SIMD paths must match the scalar one
+#include "check.h"
+#include "legacy_indicator.h"
+#include "sdf_raster.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr pixel::Isa kIsas[] = {pixel::Isa::Scalar, pixel::Isa::SSE2,
+                                pixel::Isa::AVX2};
+constexpr float kPi = 3.14159265f;
+
+struct Pose { float breath, angle; };
+
+// Over the indicator's range: breath 0.65 +- 0.35, spin up to half a turn
+std::vector<Pose> poses(int n) {
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> breath(0.3f, 1.0f);
+    std::uniform_real_distribution<float> angle(0.0f, kPi);
+    std::vector<Pose> v = {{0.3f, 0.0f}, {1.0f, 0.0f}, {0.65f, kPi}};
+    while (static_cast<int>(v.size()) < n) v.push_back({breath(rng), angle(rng)});
+    return v;
+}
+
+std::vector<uint32_t> render(int size, Pose p, pixel::Isa isa) {
+    // Poisoned so unwritten pixels show up
+    std::vector<uint32_t> v(size * size, 0xDEADBEEF);
+    sdf_raster::render(v.data(), size, p.breath, p.angle, isa);
+    return v;
+}
+
+void test_matches_legacy() {
+    constexpr int kSize = legacy::kIndicatorSize;
+    std::vector<uint32_t> want(kSize * kSize);
+    for (pixel::Isa isa : kIsas) {
+        if (!pixel::supported(isa)) {
+            std::printf("ISA %d not supported here, skipped\n",
+                        static_cast<int>(isa));
+            continue;
+        }
+        int mismatches = 0;
+        for (Pose p : poses(2000)) {
+            legacy::indicator(want.data(), p.breath, p.angle);
+            if (render(kSize, p, isa) != want && ++mismatches == 1)
+                std::printf("ISA %d differs at breath %.6f angle %.6f\n",
+                            static_cast<int>(isa), p.breath, p.angle);
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+}
+
+void test_isas_agree() {
+    for (int size : {40, 64, 77, 128}) {
+        for (Pose p : poses(200)) {
+            auto want = render(size, p, pixel::Isa::Scalar);
+            for (pixel::Isa isa : kIsas) {
+                if (!pixel::supported(isa)) continue;
+                CHECK(render(size, p, isa) == want);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    test_matches_legacy();
+    test_isas_agree();
+    return check::result();
+}
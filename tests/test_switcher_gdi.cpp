@@ -0,0 +1,70 @@
+// Opening and closing the switcher must not grow the process's GDI object
+// count, with the prewarmed surfaces and with surfaces reserved on first
+// use, and shutdown must give back everything init created. Windows only;
+// needs a desktop session (toggles move the foreground between the two
+// most recent windows).
+#include "check.h"
+#include "edge_flash.h"
+#include "frame_scheduler.h"
+#include "switcher.h"
+
+namespace {
+
+constexpr int kCycles = 200;
+
+DWORD gdi_objects() {
+    return GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS);
+}
+
+// Run the message loop (and so the switcher animations) for ms
+void pump_for(DWORD ms) {
+    UINT_PTR wake = SetTimer(nullptr, 0, 5, nullptr);
+    ULONGLONG end = GetTickCount64() + ms;
+    MSG msg;
+    while (GetTickCount64() < end && frame_scheduler::get_message(msg))
+        DispatchMessageW(&msg);
+    KillTimer(nullptr, wake);
+}
+
+void open_and_close(DWORD open_ms) {
+    switcher::toggle();
+    pump_for(open_ms);
+    switcher::hide();
+    pump_for(400);  // past the fade-out
+}
+
+void run(bool prewarm, int max_rows) {
+    HINSTANCE hInstance = GetModuleHandleW(nullptr);
+    DWORD before = gdi_objects();
+    CHECK(switcher::init(hInstance, switcher::TrackingMode::Event, max_rows,
+                         prewarm));
+    pump_for(300);  // first window list
+
+    open_and_close(600);
+    DWORD warm = gdi_objects();
+
+    // Close mid-intro as well as after it
+    for (int i = 0; i < kCycles; ++i) open_and_close(i % 2 ? 30 : 200);
+    DWORD after = gdi_objects();
+
+    switcher::shutdown();
+    DWORD done = gdi_objects();
+    std::printf("prewarm %d, %d row(s): gdi %lu, warm %lu, after %d "
+                "toggles %lu, shut down %lu\n", prewarm, max_rows, before,
+                warm, kCycles, after, done);
+    CHECK_EQ(after, warm);
+    CHECK_EQ(done, before);
+}
+
+}  // namespace
+
+int main() {
+    CHECK(frame_scheduler::init());
+    CHECK(edge_flash::init(GetModuleHandleW(nullptr)));
+    run(true, 1);
+    run(false, 1);
+    run(false, 3);
+    edge_flash::shutdown();
+    frame_scheduler::shutdown();
+    return check::result();
+}